@@ -50,6 +50,20 @@ Arguments parse_arguments(int argc, char** argv) {
             expect_value(i, argc, "--time_limit");
             args.time_limit = std::stoi(argv[++i]);
         }
+        else if (eq("--budget")) {
+            expect_value(i, argc, "--budget");
+            std::string mode = argv[++i];
+            // Mesma numeração de StopBudget (stopCriterion.hpp)
+            if (mode == "wall") args.budget = 0;
+            else if (mode == "cpu") args.budget = 1;
+            else if (mode == "thread_cpu") args.budget = 2;
+            else if (mode == "work") args.budget = 3;
+            else throw std::runtime_error("--budget must be wall, cpu, thread_cpu or work");
+        }
+        else if (eq("--budget_limit")) {
+            expect_value(i, argc, "--budget_limit");
+            args.budget_limit = std::stod(argv[++i]);
+        }
         else if (eq("--max_iter")) {
             expect_value(i, argc, "--max_iter");
             args.max_iter = std::stoi(argv[++i]);
@@ -62,11 +76,175 @@ Arguments parse_arguments(int argc, char** argv) {
             expect_value(i, argc, "--perturbation_strength");
             args.perturbation_strength = std::stof(argv[++i]);
         }
+        else if (eq("--chain_moves")) {
+            expect_value(i, argc, "--chain_moves");
+            args.chain_moves = std::stoi(argv[++i]);
+            if (args.chain_moves < 0) {
+                throw std::runtime_error("--chain_moves must be >= 0");
+            }
+        }
+        else if (eq("--threads")) {
+            expect_value(i, argc, "--threads");
+            args.threads = std::stoi(argv[++i]);
+        }
+        else if (eq("--autotune")) {
+            expect_value(i, argc, "--autotune");
+            args.autotune = std::stoi(argv[++i]);
+            if (args.autotune != 0 && args.autotune != 1) {
+                throw std::runtime_error("--autotune must be 0 or 1");
+            }
+        }
+        else if (eq("--autotune_ms")) {
+            expect_value(i, argc, "--autotune_ms");
+            args.autotune_ms = std::stoi(argv[++i]);
+        }
+        else if (eq("--scan")) {
+            expect_value(i, argc, "--scan");
+            std::string mode = argv[++i];
+            if (mode == "full") args.scan_mode = 0;
+            else if (mode == "sampled") args.scan_mode = 1;
+            else if (mode == "first") args.scan_mode = 2;
+            else throw std::runtime_error("--scan must be full, sampled or first");
+        }
+        else if (eq("--sample_vertices")) {
+            expect_value(i, argc, "--sample_vertices");
+            args.sample_vertices = std::stoi(argv[++i]);
+        }
+        else if (eq("--sample_classes")) {
+            expect_value(i, argc, "--sample_classes");
+            args.sample_classes = std::stoi(argv[++i]);
+        }
+        else if (eq("--sample_partners")) {
+            expect_value(i, argc, "--sample_partners");
+            args.sample_partners = std::stoi(argv[++i]);
+        }
+        else if (eq("--sample_adapt")) {
+            expect_value(i, argc, "--sample_adapt");
+            args.sample_adapt = std::stoi(argv[++i]);
+            if (args.sample_adapt != 0 && args.sample_adapt != 1) {
+                throw std::runtime_error("--sample_adapt must be 0 or 1");
+            }
+        }
+        else if (eq("--first_budget")) {
+            expect_value(i, argc, "--first_budget");
+            args.first_budget = std::stoll(argv[++i]);
+        }
+        else if (eq("--batch")) {
+            expect_value(i, argc, "--batch");
+            args.batch = std::stoi(argv[++i]);
+            if (args.batch != 0 && args.batch != 1) {
+                throw std::runtime_error("--batch must be 0 or 1");
+            }
+        }
+        else if (eq("--slice")) {
+            expect_value(i, argc, "--slice");
+            args.slice = std::stoll(argv[++i]);
+        }
+        else if (eq("--batch_active")) {
+            expect_value(i, argc, "--batch_active");
+            args.batch_active = std::stoi(argv[++i]);
+        }
+        else if (eq("--tiny")) {
+            expect_value(i, argc, "--tiny");
+            args.tiny = std::stoi(argv[++i]);
+            if (args.tiny != 0 && args.tiny != 1) {
+                throw std::runtime_error("--tiny must be 0 or 1");
+            }
+        }
+        else if (eq("--metrics_file")) {
+            expect_value(i, argc, "--metrics_file");
+            args.metrics_file = argv[++i];
+        }
+        else if (eq("--metrics_interval_ms")) {
+            expect_value(i, argc, "--metrics_interval_ms");
+            args.metrics_interval_ms = std::stoi(argv[++i]);
+        }
+        else if (eq("--mem_limit_mb")) {
+            expect_value(i, argc, "--mem_limit_mb");
+            args.mem_limit_mb = std::stoll(argv[++i]);
+        }
+        else if (eq("--mem_policy")) {
+            expect_value(i, argc, "--mem_policy");
+            std::string policy = argv[++i];
+            if (policy == "refuse") args.mem_policy = 0;
+            else if (policy == "downgrade") args.mem_policy = 1;
+            else throw std::runtime_error("--mem_policy must be refuse or downgrade");
+        }
+        else if (eq("--mem_report")) {
+            expect_value(i, argc, "--mem_report");
+            args.mem_report = std::stoi(argv[++i]);
+        }
+        else if (eq("--adjacency")) {
+            expect_value(i, argc, "--adjacency");
+            std::string mode = argv[++i];
+            // Mesma numeração de tabueqcol::Storage (storage.hpp)
+            if (mode == "csr") args.adjacency = 0;
+            else if (mode == "compressed") args.adjacency = 1;
+            else if (mode == "lists") args.adjacency = 2;
+            else if (mode == "bitset") args.adjacency = 3;
+            else if (mode == "complement") args.adjacency = 4;
+            else throw std::runtime_error("--adjacency must be csr, compressed, lists, bitset or complement");
+        }
+        else if (eq("--external_out")) {
+            expect_value(i, argc, "--external_out");
+            args.external_out = argv[++i];
+        }
+        else if (eq("--external_chunk_mb")) {
+            expect_value(i, argc, "--external_chunk_mb");
+            args.external_chunk_mb = std::stoi(argv[++i]);
+        }
+        else if (eq("--portfolio")) {
+            expect_value(i, argc, "--portfolio");
+            args.portfolio = std::stoi(argv[++i]);
+            if (args.portfolio != 0 && args.portfolio != 1) {
+                throw std::runtime_error("--portfolio must be 0 or 1");
+            }
+        }
+        else if (eq("--probe_depth")) {
+            expect_value(i, argc, "--probe_depth");
+            args.probe_depth = std::stoi(argv[++i]);
+            if (args.probe_depth < 0) {
+                throw std::runtime_error("--probe_depth must be >= 0");
+            }
+        }
+        else if (eq("--class_pool")) {
+            expect_value(i, argc, "--class_pool");
+            args.class_pool = std::stoi(argv[++i]);
+            if (args.class_pool < 0) {
+                throw std::runtime_error("--class_pool must be >= 0");
+            }
+        }
+        else if (eq("--components")) {
+            expect_value(i, argc, "--components");
+            args.components = std::stoi(argv[++i]);
+            if (args.components != 0 && args.components != 1) {
+                throw std::runtime_error("--components must be 0 or 1");
+            }
+        }
+        else if (eq("--online")) {
+            expect_value(i, argc, "--online");
+            args.online = std::stoi(argv[++i]);
+            if (args.online != 0 && args.online != 1) {
+                throw std::runtime_error("--online must be 0 or 1");
+            }
+        }
+        else if (eq("--online_k")) {
+            expect_value(i, argc, "--online_k");
+            args.online_k = std::stoi(argv[++i]);
+        }
+        else if (eq("--solution_out")) {
+            expect_value(i, argc, "--solution_out");
+            args.solution_file = argv[++i];
+        }
         else {
             throw std::runtime_error(std::string("Unknown argument: ") + argv[i]);
         }
     }
 
 
+    if (args.budget != 0 && args.budget_limit <= 0) {
+        throw std::runtime_error("--budget cpu|thread_cpu|work requires --budget_limit > 0");
+    }
+
     return args;
 }
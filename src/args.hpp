@@ -6,6 +6,7 @@
 struct Arguments {
     std::string input_file;
     std::string output_file;
+    std::string solution_file; // opcional: grava a melhor coloração (verificada)
 
     int k;
     int seed = 0;
@@ -13,9 +14,39 @@ struct Arguments {
     int beta = 10;
     int aspiration = 1; // 0 = off, 1 = on
     int time_limit = 1000; // seconds
+    int budget = 0; // --budget wall|cpu|thread_cpu|work (StopBudget, stopCriterion.hpp); time_limit continua como teto
+    double budget_limit = 0; // segundos de CPU ou unidades de trabalho
     int max_iter = 1000000;
     int perturbation_limit = 1000; // iterations without improvement before perturbation
     float perturbation_strength = 0.16; // floor(perturbation_strength * n)
+    int threads = 0; // threads da varredura de exchange; 0 = uma sem --autotune, todos os núcleos na calibração
+    int autotune = 0; // 1 = calibra os kernels na partida (opt-in: sem ela, os kernels da linha de comando)
+    int autotune_ms = 100; // orçamento da calibração
+    int scan_mode = 0; // --scan full|sampled|first
+    int sample_vertices = 32; // modo amostrado: vértices de C(s) por iteração
+    int sample_classes = 8; // modo amostrado: classes alvo por vértice
+    int sample_partners = 4; // modo amostrado: parceiros de exchange por classe
+    int sample_adapt = 1; // 1 = ajusta as amostras durante a busca
+    int batch = 0; // 1 = input_file lista uma instância por linha (modo lote)
+    long long slice = 256; // modo lote: iterações por fatia
+    int batch_active = 4; // modo lote: jobs intercalados por thread
+    int tiny = 1; // modo lote: grafos com n <= 64 vão para o kernel em lockstep
+    std::string metrics_file; // opcional: métricas ao vivo (formato texto do Prometheus)
+    int metrics_interval_ms = 1000; // período de gravação das métricas
+    long long mem_limit_mb = 0; // 0 = sem limite; acima dele recusa ou rebaixa (mem_policy)
+    int mem_policy = 1; // --mem_policy refuse|downgrade
+    int mem_report = 0; // 1 = imprime RSS por fase e bytes por estrutura
+    int adjacency = 0; // --adjacency csr|compressed|lists|bitset|complement (storage.hpp)
+    std::string external_out; // opcional: grava a instância no formato em disco (.ecsr) e sai
+    int external_chunk_mb = 8; // modo semi-externo (entrada .ecsr): MB por leitura da pré-busca
+    int portfolio = 0; // 1 = variantes do solver competem pelo mesmo k (portfolio.hpp)
+    int chain_moves = 0; // > 0: perturbação por cadeias de ejeção (reequilíbrio por caminhos de aumento)
+    int probe_depth = 0; // > 0: após a primeira falha, sonda até N ks abaixo do melhor (probing.hpp)
+    int class_pool = 0; // > 0: rodadas de recombinação do pool de classes por k após a primeira falha (recombination.hpp)
+    int components = 1; // 1 = grafo desconexo resolvido por componente
+    int online = 0; // 1 = vértices chegam um a um (ordem dos ids) e a coloração é mantida online
+    int online_k = 1; // modo online: cores iniciais
+    long long first_budget = 1 << 14; // --scan first: avaliações antes do melhor-da-amostra (0 = best improvement completo)
 };
 
 Arguments parse_arguments(int argc, char** argv);
@@ -0,0 +1,168 @@
+// autotune.hpp
+// C++17 header-only: calibração de kernels na partida (~100 ms)
+//
+// As variantes de kernel (adjacência CSR/bitset, contadores esparsos/densos, varredura
+// escalar/em blocos, serial/paralela) produzem exatamente os mesmos movimentos para a
+// mesma seed; só o custo muda. Então cada variante roda a mesma busca, a partir do mesmo
+// estado inicial, por uma fatia do orçamento, e vence a que fizer mais iterações/s.
+//
+// Usage example (sketch):
+//   auto tune = tabueqcol::autotune_kernels(inst, config, seed, 0.1, threads);
+//   tune.apply(config);
+//   if (tune.use_bitset) { BitsetGraph B(inst); ... }
+//
+
+#pragma once
+#include <vector>
+#include <string>
+#include <type_traits>
+#include "tabu_search.hpp"
+#include "bitset_graph.hpp"
+
+namespace tabueqcol {
+
+struct KernelTiming {
+    bool bitset = false;
+    int dense_counters = 0;
+    int block_scan = 0;
+    int threads = 1;
+    int iterations = 0;
+    double seconds = 0.0;
+    double rate = 0.0;     // iterações por segundo
+
+    std::string name() const {
+        return std::string(bitset ? "bitset" : "csr") + "/" + (dense_counters ? "dense" : "sparse") + "/" +
+               (block_scan ? "block" : "scalar") + "/x" + std::to_string(threads);
+    }
+};
+
+struct AutotuneReport {
+    bool use_bitset = false;
+    int dense_counters = 0;
+    int block_scan = 0;
+    int threads = 1;
+    double total_seconds = 0.0;
+    std::vector<KernelTiming> timings;
+
+    void apply(TabuConfig& c) const {
+        c.dense_counters = dense_counters;
+        c.block_scan = block_scan;
+        c.threads = threads;
+    }
+
+    std::string choice() const {
+        KernelTiming t;
+        t.bitset = use_bitset; t.dense_counters = dense_counters; t.block_scan = block_scan; t.threads = threads;
+        return t.name();
+    }
+};
+
+// Limites de memória para considerar as variantes (a calibração não deve estourar a RAM)
+struct AutotuneLimits {
+    size_t bitset_bytes = 64ull << 20;    // matriz de bits n x n
+    size_t counter_bytes = 512ull << 20;  // contadores densos n x k
+};
+
+namespace detail {
+
+// Roda uma variante a partir de 'start' (mesmo estado e seed para todas) e mede iterações/s.
+// Se a busca resolver antes do fim da fatia, recomeça do mesmo estado e acumula.
+template <class Graph>
+inline KernelTiming time_kernel(const Graph& g, const std::vector<int>& start, int k,
+                                TabuConfig cfg, int seed, double seconds) {
+    KernelTiming t;
+    t.dense_counters = cfg.dense_counters;
+    t.block_scan = cfg.block_scan;
+    t.threads = cfg.threads;
+
+    cfg.max_iter = std::numeric_limits<int>::max();
+    cfg.time_check_every = 1;
+    StopCriterion stop(seconds);
+
+    BasicSolutionManager<Graph> S(g, k);
+    do {
+        S.compute_from_coloring(start);
+        auto r = S.run_tabu_search(cfg, stop, seed);
+        t.iterations += r.iterations;
+        t.seconds += r.search_seconds;
+        if (r.iterations == 0) break;
+    } while (!stop.is_time_up());
+
+    t.rate = t.seconds > 0 ? t.iterations / t.seconds : 0.0;
+    return t;
+}
+
+} // namespace detail
+
+template <class Graph>
+inline AutotuneReport autotune_kernels(const Graph& g, const TabuConfig& base, int seed, double budget_seconds,
+                                       int max_threads, AutotuneLimits limits = AutotuneLimits()) {
+    StopCriterion clock(0);
+    AutotuneReport rep;
+
+    // Estado de calibração: a primeira construção. Se ela já não tem conflitos (comum em
+    // k = Delta + 1), não há busca para medir: reduz k pela metade até aparecerem conflitos.
+    BasicSolutionManager<Graph> S0(g, -1);
+    S0.construct_greedy_initial(seed);
+    while (S0.obj == 0 && S0.k > 2) {
+        S0 = BasicSolutionManager<Graph>(g, std::max(2, S0.k / 2));
+        S0.construct_greedy_initial(seed);
+    }
+    if (S0.obj == 0) {
+        rep.total_seconds = clock.get_elapsed();
+        return rep; // nada a calibrar: fica a variante padrão
+    }
+
+    std::vector<bool> adj_options = { false };
+    std::unique_ptr<BitsetGraph> bitset;
+    if constexpr (std::is_same_v<Graph, Instance>) {
+        if (BitsetGraph::bytes_for(g.n) <= limits.bitset_bytes) {
+            bitset.reset(new BitsetGraph(g));
+            adj_options.push_back(true);
+        }
+    }
+
+    std::vector<int> counter_options = { 0 };
+    if ((size_t)g.n * S0.k * sizeof(int) <= limits.counter_bytes) counter_options.push_back(1);
+
+    std::vector<int> thread_options = { 1 };
+    if (max_threads > 1) thread_options.push_back(max_threads);
+
+    struct Variant { bool bitset; int dense; int block; int threads; };
+    std::vector<Variant> variants;
+    for (bool bs : adj_options)
+        for (int d : counter_options)
+            for (int blk = 0; blk <= d; ++blk)
+                for (int th : thread_options)
+                    variants.push_back({ bs, d, blk, th });
+
+    double slice = budget_seconds / variants.size();
+    double best_rate = -1.0;
+
+    for (auto &var : variants) {
+        TabuConfig cfg = base;
+        cfg.dense_counters = var.dense;
+        cfg.block_scan = var.block;
+        cfg.threads = var.threads;
+
+        KernelTiming t;
+        if (var.bitset) t = detail::time_kernel(*bitset, S0.color, S0.k, cfg, seed, slice);
+        else            t = detail::time_kernel(g, S0.color, S0.k, cfg, seed, slice);
+        t.bitset = var.bitset;
+        rep.timings.push_back(t);
+
+        // Empate fica com a variante anterior (mais simples)
+        if (t.rate > best_rate) {
+            best_rate = t.rate;
+            rep.use_bitset = var.bitset;
+            rep.dense_counters = var.dense;
+            rep.block_scan = var.block;
+            rep.threads = var.threads;
+        }
+    }
+
+    rep.total_seconds = clock.get_elapsed();
+    return rep;
+}
+
+} // namespace tabueqcol
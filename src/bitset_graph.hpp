@@ -0,0 +1,68 @@
+// bitset_graph.hpp
+// C++17 header-only: adjacência em matriz de bits (n x n bits)
+//
+// adjacent(u, v) em O(1) e enumeração de vizinhos por palavras de 64 bits.
+// Compensa em grafos densos ou médios com n moderado; segue o conceito de grafo
+// de tabu_search.hpp, então BasicSolutionManager<BitsetGraph> roda sem mudanças.
+//
+
+#pragma once
+#include <vector>
+#include <cstdint>
+#include "tabu_search.hpp"
+#include "parallel.hpp"
+
+namespace tabueqcol {
+
+struct BitsetGraph {
+    int n = 0;
+    int max_degree = 0;
+    int words = 0;                  // palavras de 64 bits por linha
+    std::vector<uint64_t> bits;     // linha v em bits[v*words .. (v+1)*words)
+    std::vector<int> degrees;
+
+    BitsetGraph() = default;
+
+    explicit BitsetGraph(const Instance& I) : n(I.n), max_degree(I.max_degree), degrees(I.degrees) {
+        words = (n + 63) / 64;
+        bits.assign((size_t)n * words, 0);
+        parallel_for(0, n, [&](long long lo, long long hi, int) {
+            for (long long v = lo; v < hi; ++v) {
+                uint64_t* row = bits.data() + (size_t)v * words;
+                for (int u : I.adj[(int)v]) row[u >> 6] |= 1ULL << (u & 63);
+            }
+        });
+    }
+
+    // Memória necessária para n vértices (para decidir antes de construir)
+    static size_t bytes_for(int n) {
+        return (size_t)n * (size_t)((n + 63) / 64) * sizeof(uint64_t);
+    }
+
+    int degree(int v) const { return degrees[v]; }
+
+    bool adjacent(int u, int v) const {
+        return (bits[(size_t)u * words + (v >> 6)] >> (v & 63)) & 1ULL;
+    }
+
+    void memory_report(MemoryReport& R) const {
+        R.add("bitset.bits", vector_bytes(bits));
+        R.add("bitset.degrees", vector_bytes(degrees));
+    }
+
+    // Vizinhos em ordem crescente (mesma ordem das linhas do CSR)
+    template <class F>
+    void for_each_neighbour(int v, F&& f) const {
+        const uint64_t* row = bits.data() + (size_t)v * words;
+        for (int w = 0; w < words; ++w) {
+            uint64_t x = row[w];
+            while (x) {
+                int u = (w << 6) | ctz64(x);
+                if (!visit_neighbour(f, u)) return;
+                x &= x - 1;
+            }
+        }
+    }
+};
+
+} // namespace tabueqcol
@@ -0,0 +1,97 @@
+// class_pool.hpp
+// C++17 header-only: pool de classes de cor sem conflito colhidas pelas buscas tabu
+//
+// Usage example (sketch):
+//   ClassPool pool;
+//   config.class_pool = &pool;                    // o laço do tabu deposita as suas classes
+//   ... buscas em vários k ...
+//   auto C = pool.snapshot(f, f + 1);             // classes de tamanho f ou f + 1
+//
+// Uma classe entra quando nenhum dos seus vértices tem conflito (conjunto independente).
+// O laço colhe nos ótimos locais (antes de cada perturbação) e ao fim de cada busca, então
+// o pool junta classes de todos os k e de todas as tentativas; o tamanho de uma classe não
+// depende de k, e a recombinação (recombination.hpp) filtra pelo tamanho que o alvo exige.
+// Classes repetidas são descartadas por hash; acima de 'capacity' entradas de vértice as
+// mais antigas saem primeiro. Compartilhado entre threads (uma trava, colheita rara).
+
+#pragma once
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <unordered_set>
+#include <vector>
+
+namespace tabueqcol {
+
+class ClassPool {
+public:
+    explicit ClassPool(long long capacity = 1LL << 22) : capacity(capacity) {}
+
+    // Colhe as classes c de 'color' (cores em [0, k)) com free_class[c] != 0
+    void add_coloring(const std::vector<int>& color, int k, const std::vector<char>& free_class) {
+        std::vector<std::vector<int>> by_class(k);
+        for (int v = 0; v < (int)color.size(); ++v) {
+            if (free_class[color[v]]) by_class[color[v]].push_back(v); // vértices em ordem crescente
+        }
+        std::lock_guard<std::mutex> lk(mu);
+        harvests++;
+        for (auto& c : by_class) {
+            if (c.size() < 2) continue; // singletons não restringem nada
+            uint64_t h = hash(c);
+            if (!seen.insert(h).second) continue;
+            entries += (long long)c.size();
+            classes.push_back({h, std::move(c)});
+            while (entries > capacity && classes.size() > 1) {
+                entries -= (long long)classes.front().vertices.size();
+                seen.erase(classes.front().key);
+                classes.pop_front();
+            }
+        }
+    }
+
+    // Cópia das classes com tamanho em [lo, hi]
+    std::vector<std::vector<int>> snapshot(int lo, int hi) const {
+        std::lock_guard<std::mutex> lk(mu);
+        std::vector<std::vector<int>> out;
+        for (const auto& c : classes) {
+            int s = (int)c.vertices.size();
+            if (s >= lo && s <= hi) out.push_back(c.vertices);
+        }
+        return out;
+    }
+
+    size_t size() const {
+        std::lock_guard<std::mutex> lk(mu);
+        return classes.size();
+    }
+
+    long long harvest_count() const {
+        std::lock_guard<std::mutex> lk(mu);
+        return harvests;
+    }
+
+private:
+    struct Entry {
+        uint64_t key;
+        std::vector<int> vertices;
+    };
+
+    // FNV-1a sobre os ids (a lista já vem ordenada)
+    static uint64_t hash(const std::vector<int>& c) {
+        uint64_t h = 1469598103934665603ULL;
+        for (int v : c) {
+            h ^= (uint64_t)(uint32_t)v;
+            h *= 1099511628211ULL;
+        }
+        return h ^ (uint64_t)c.size();
+    }
+
+    long long capacity;
+    long long entries = 0; // vértices guardados no total
+    long long harvests = 0;
+    std::deque<Entry> classes; // ordem de chegada (descarte FIFO)
+    std::unordered_set<uint64_t> seen;
+    mutable std::mutex mu;
+};
+
+} // namespace tabueqcol
@@ -0,0 +1,295 @@
+// components.hpp
+// C++17 header-only: decomposição em componentes conexas + recombinação equitativa
+//
+// Usage example (sketch):
+//   auto split = tabueqcol::connected_components(inst);
+//   if (split.count() > 1) {
+//       auto D = tabueqcol::run_component_descent(inst, split, config, stop, seed, max_iter, threads);
+//       D.best.color / D.best_k                 // mesma interface de run_descent
+//   }
+//
+// Cada componente é resolvida isoladamente (em paralelo), com sua própria descida em k.
+// Com K = max k_i, cada componente recebe uma coloração equitativa com K cores
+// (classes de tamanho q_i ou q_i + 1, r_i = n_i mod K classes grandes). Na união, as
+// classes grandes de cada componente ocupam as cores globais p, p+1, ..., p+r_i-1
+// (mod K) e p avança r_i: toda cor global recebe sum q_i mais 0 ou 1, ou seja, a união
+// é equitativa. Só as componentes que não fecharam em K deixam conflitos; esse
+// resíduo passa pela busca global.
+
+#pragma once
+#include "descent.hpp"
+#include "sampling.hpp"
+#include <vector>
+#include <algorithm>
+#include <limits>
+#include <numeric>
+
+namespace tabueqcol {
+
+struct ComponentSplit {
+    std::vector<int> comp_of;               // comp_of[v]
+    std::vector<std::vector<int>> vertices; // vértices de cada componente (crescentes), maiores primeiro
+
+    int count() const { return (int)vertices.size(); }
+};
+
+// BFS sobre o CSR. Os vértices isolados não viram subproblemas de um vértice: são
+// repartidos entre as componentes proporcionalmente ao tamanho. Como completam qualquer
+// classe, afrouxam a equidade exigida de cada componente (sem eles, uma componente
+// pequena e densa exigiria k alto mesmo que o grafo todo aceitasse k menor).
+inline ComponentSplit connected_components(const Instance& I) {
+    ComponentSplit S;
+    S.comp_of.assign(I.n, -1);
+    std::vector<int> isolated;
+    std::vector<int> queue;
+    queue.reserve(I.n);
+
+    for (int s = 0; s < I.n; ++s) {
+        if (S.comp_of[s] != -1) continue;
+        if (I.degree(s) == 0) {
+            isolated.push_back(s);
+            continue;
+        }
+        int id = (int)S.vertices.size();
+        queue.clear();
+        queue.push_back(s);
+        S.comp_of[s] = id;
+        for (size_t h = 0; h < queue.size(); ++h) {
+            for (int u : I.adj[queue[h]]) {
+                if (S.comp_of[u] == -1) {
+                    S.comp_of[u] = id;
+                    queue.push_back(u);
+                }
+            }
+        }
+        std::sort(queue.begin(), queue.end());
+        S.vertices.push_back(queue);
+    }
+    if (!isolated.empty()) {
+        if (S.vertices.empty()) {
+            S.vertices.push_back(isolated);
+        } else {
+            long long total = I.n - (long long)isolated.size();
+            size_t next = 0;
+            for (auto& comp : S.vertices) {
+                size_t share = (size_t)((long long)isolated.size() * (long long)comp.size() / total);
+                for (size_t i = 0; i < share && next < isolated.size(); ++i) comp.push_back(isolated[next++]);
+            }
+            // Resto do arredondamento: um para cada componente, em ordem
+            for (size_t c = 0; next < isolated.size(); c = (c + 1) % S.vertices.size()) {
+                S.vertices[c].push_back(isolated[next++]);
+            }
+            for (auto& comp : S.vertices) std::sort(comp.begin(), comp.end());
+        }
+    }
+
+    // Maiores primeiro: com distribuição dinâmica, as longas começam antes
+    std::stable_sort(S.vertices.begin(), S.vertices.end(),
+                     [](const std::vector<int>& a, const std::vector<int>& b) { return a.size() > b.size(); });
+    for (int c = 0; c < S.count(); ++c) {
+        for (int v : S.vertices[c]) S.comp_of[v] = c;
+    }
+    return S;
+}
+
+// Une colorações equitativas com K cores das componentes numa coloração equitativa do
+// grafo todo (deslocamento cíclico das classes grandes, ver cabeçalho)
+inline std::vector<int> combine_component_colorings(int n, const ComponentSplit& split,
+                                                    const std::vector<std::vector<int>>& local_color, int K) {
+    std::vector<int> color(n, -1);
+    std::vector<int> order(K), size(K);
+    int p = 0;
+    for (int c = 0; c < split.count(); ++c) {
+        const auto& verts = split.vertices[c];
+        const auto& lc = local_color[c];
+        std::fill(size.begin(), size.end(), 0);
+        for (int x : lc) size[x]++;
+
+        // Classes locais: grandes primeiro (ordem estável)
+        std::iota(order.begin(), order.end(), 0);
+        int q = (int)verts.size() / K;
+        std::stable_partition(order.begin(), order.end(), [&](int x) { return size[x] > q; });
+        int r = (int)verts.size() - q * K;
+
+        std::vector<int> to_global(K);
+        for (int i = 0; i < K; ++i) to_global[order[i]] = (p + i) % K;
+        for (size_t i = 0; i < verts.size(); ++i) color[verts[i]] = to_global[lc[i]];
+        p = (p + r) % K;
+    }
+    return color;
+}
+
+inline DescentResult<Instance> run_component_descent(const Instance& inst, const ComponentSplit& split,
+                                                     TabuConfig config, const StopCriterion& stop,
+                                                     int seed, long long max_iter, int threads = 0) {
+    const int C = split.count();
+    if (threads <= 0) threads = default_thread_count();
+    const int residue_threads = config.scan_mode == 0 ? threads : 1;
+    config.threads = 1; // o paralelismo é entre componentes
+
+    // --- 1. Descida independente por componente ---
+    std::vector<Instance> sub(C);
+    parallel_for(0, C, [&](long long lo, long long hi, int) {
+        for (long long c = lo; c < hi; ++c) sub[c] = induced_subgraph(inst, split.vertices[c]);
+    }, threads, 1);
+
+    // Reserva parte do tempo para o acoplamento (K acima do k de algumas componentes + resíduo).
+    // Cada componente tem o seu orçamento (trabalho proporcional a n_c): as descidas rodam em
+    // paralelo e não podem parar pela soma das outras
+    auto component_stops = [&](double fraction) {
+        std::vector<StopCriterion> S;
+        for (int c = 0; c < C; ++c) S.push_back(stop.concurrent_share(fraction, (double)sub[c].n / inst.n));
+        return S;
+    };
+    std::vector<StopCriterion> stop_split = component_stops(0.7);
+
+    // Toda descida termina numa busca que falha e gasta o orçamento inteiro. O orçamento
+    // de iterações cai com o quadrado do tamanho relativo à maior componente com arestas
+    // (o custo por iteração também cresce com n_c), e as descidas de cada worker rodam
+    // intercaladas em fatias (DescentJob): as grandes não esperam as pequenas nem o contrário.
+    // Como o tempo, a fase 1 fica com 70% de max_iter, repartidos por esse peso
+    double n_max = 1.0;
+    for (int c = 0; c < C; ++c) {
+        if (sub[c].m > 0) n_max = std::max(n_max, (double)sub[c].n);
+    }
+    std::vector<double> weight(C);
+    double weight_sum = 0.0;
+    for (int c = 0; c < C; ++c) {
+        double rel = std::min(1.0, sub[c].n / n_max);
+        weight[c] = rel * rel;
+        weight_sum += weight[c];
+    }
+    std::vector<std::unique_ptr<DescentJob<Instance>>> jobs(C);
+    for (int c = 0; c < C; ++c) {
+        long long budget = std::max<long long>(1000, (long long)(0.7 * max_iter * weight[c] / weight_sum));
+        jobs[c].reset(new DescentJob<Instance>(sub[c], config, seed, budget));
+    }
+    const int workers = std::min(threads, C);
+    const long long SLICE = 256;
+    parallel_for(0, workers, [&](long long, long long, int tid) {
+        // Componentes tid, tid + workers, ... (a ordem por tamanho equilibra os workers)
+        std::vector<int> ring;
+        for (int c = tid; c < C; c += workers) ring.push_back(c);
+        while (!ring.empty()) {
+            for (size_t i = 0; i < ring.size();) {
+                if (jobs[ring[i]]->step(stop_split[ring[i]], SLICE)) {
+                    ring[i] = ring.back();
+                    ring.pop_back();
+                } else {
+                    ++i;
+                }
+            }
+        }
+    }, workers, 1);
+    for (const auto& s : stop_split) stop.absorb(s);
+
+    std::vector<DescentResult<Instance>*> part(C);
+    std::vector<long long> iterations(C, 0);
+    for (int c = 0; c < C; ++c) {
+        part[c] = &jobs[c]->result();
+        iterations[c] = part[c]->total_iterations;
+    }
+
+    int K = 1;
+    for (int c = 0; c < C; ++c) K = std::max(K, part[c]->best_k);
+
+    DescentResult<Instance> D;
+    D.initial_k = inst.max_degree + 1;
+    D.best_k = D.initial_k;
+    D.best = BasicSolutionManager<Instance>(inst, -1);
+    D.best.construct_greedy_initial(seed);
+
+    // Iterações que ainda cabem em max_iter (fases 1 e 2 por componente, resíduo e fase 3)
+    auto remaining = [&]() {
+        long long spent = D.total_iterations;
+        for (long long it : iterations) spent += it;
+        return max_iter - spent;
+    };
+    auto capped = [](long long iters) { return (int)std::min<long long>(iters, std::numeric_limits<int>::max()); };
+
+    // Buscas no grafo todo (resíduo e fase 3): cada iteração varre C(s) contra n vértices,
+    // então o relógio é consultado mais vezes para não estourar o tempo limite
+    TabuConfig whole = config;
+    whole.threads = residue_threads;
+    whole.time_check_every = std::min(config.time_check_every, 8);
+
+    // O perfil registra as tentativas no grafo todo: em cada K da fase 2, as buscas das
+    // componentes e do resíduo contam como uma tentativa; na fase 3, uma por busca
+    auto record = [&](int k, bool solved, long long iters, long long obj, double seconds) {
+        D.profile.push_back({k, solved, iters, obj, seconds});
+    };
+
+    // --- 2. Coloração equitativa com K cores por componente, união e resíduo ---
+    // Cada rodada dá às componentes metade do tempo restante (em paralelo) e, do que sobra
+    // de max_iter, a parte proporcional a n_c; o resto fica para o resíduo e a fase 3
+    std::vector<std::vector<int>> local_color(C);
+    for (; K <= D.initial_k && !stop.is_time_up() && remaining() > 0; ++K) {
+        const double t0 = stop.get_elapsed();
+        const long long left = remaining();
+        long long round_iterations = 0;
+        std::vector<long long> round_iters(C, 0);
+        std::vector<StopCriterion> stop_round = component_stops(0.5);
+        parallel_for(0, C, [&](long long lo, long long hi, int) {
+            for (long long c = lo; c < hi; ++c) {
+                const Instance& g = sub[c];
+                if (part[c]->best_k == K) {
+                    local_color[c] = part[c]->best.color;
+                } else if (g.n <= K) {
+                    // Cada vértice com sua cor: classes de tamanho 0 ou 1
+                    local_color[c].resize(g.n);
+                    std::iota(local_color[c].begin(), local_color[c].end(), 0);
+                } else {
+                    TabuConfig share = config;
+                    share.max_iter = capped(std::max<long long>(1, (long long)((double)left * g.n / inst.n)));
+                    BasicSolutionManager<Instance> S(g, K);
+                    S.construct_greedy_initial(seed);
+                    auto r = S.run_tabu_search(share, stop_round[c], seed);
+                    round_iters[c] = r.iterations;
+                    local_color[c] = S.color; // equitativa mesmo se sobrar conflito
+                }
+            }
+        }, threads, 1);
+        for (const auto& s : stop_round) stop.absorb(s);
+        for (int c = 0; c < C; ++c) {
+            iterations[c] += round_iters[c];
+            round_iterations += round_iters[c];
+        }
+
+        BasicSolutionManager<Instance> G(inst, K);
+        G.compute_from_coloring(combine_component_colorings(inst.n, split, local_color, K));
+        if (G.obj > 0 && remaining() > 0) {
+            // Resíduo acoplado: só as componentes que não fecharam têm conflitos
+            whole.max_iter = capped(remaining());
+            auto r = G.run_tabu_search(whole, stop, seed);
+            D.total_iterations += r.iterations;
+            round_iterations += r.iterations;
+        }
+        record(K, G.obj == 0, round_iterations, G.obj, stop.get_elapsed() - t0);
+        if (G.obj == 0) {
+            D.best = G;
+            D.best_k = K;
+            break;
+        }
+    }
+
+    // --- 3. Descida global a partir da união ---
+    // A exigência de equidade por componente é mais forte que a global (classes de uma
+    // componente podem compensar as de outra, e vértices isolados completam qualquer
+    // classe): com o tempo e as iterações que sobram, a descida continua no grafo todo
+    while (D.best_k > 1 && !stop.is_time_up() && remaining() > 0) {
+        whole.max_iter = capped(remaining());
+        BasicSolutionManager<Instance> nextS(inst, D.best_k - 1);
+        nextS.construct_greedy_from_previous(D.best, seed);
+        auto r = nextS.run_tabu_search(whole, stop, seed);
+        D.total_iterations += r.iterations;
+        record(nextS.k, r.solved, r.iterations, r.final_obj, r.search_seconds);
+        if (!r.solved) break;
+        D.best = nextS;
+        D.best_k = nextS.k;
+    }
+
+    for (long long it : iterations) D.total_iterations += it;
+    return D;
+}
+
+} // namespace tabueqcol
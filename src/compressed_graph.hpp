@@ -0,0 +1,268 @@
+// compressed_graph.hpp
+// C++17 header-only: adjacência comprimida (gaps + stream-VByte) com decodificação sob demanda
+//
+// Usage example (sketch):
+//   tabueqcol::Instance inst = tabueqcol::read_instance(path, false);   // só a lista de arestas
+//   auto C = tabueqcol::CompressedGraph::from_edges(inst);              // sem passar pelo CSR
+//   BasicSolutionManager<CompressedGraph> S(C, k);
+//
+// from_edges codifica direto das linhas ordenadas de Instance::build_rows: o pico da
+// construção é o das linhas brutas mais os bytes comprimidos, sem o CSR compacto. O
+// construtor a partir de um Instance pronto continua disponível (autotune, ferramentas).
+//
+// Cada linha começa pelo grau (varint LEB128) e guarda os vizinhos ordenados como diferenças: o primeiro relativo ao próprio
+// vértice (zigzag, pequeno quando os ids têm localidade) e os demais como u_i - u_{i-1}.
+// As diferenças vão no formato stream-VByte: um byte de controle para cada grupo de 4
+// valores (2 bits = 1..4 bytes por valor) e os bytes de dados logo depois. Os grupos são
+// decodificados com um pshufb (tabela de 256 máscaras indexada pelo byte de controle) e
+// uma soma de prefixo no registrador; sem SSSE3, o mesmo formato é lido byte a byte.
+// Em grafos esparsos com ids locais, os 4 bytes por vizinho do CSR caem para 1 a 2.
+// O início de cada linha é um deslocamento de 32 bits relativo ao seu bloco de 64 linhas
+// (base de 64 bits por bloco): por vértice ficam ~4 bytes de índice e 1 a 2 de grau, no
+// lugar dos 8 do offset e 4 do grau do CSR.
+//
+// Segue o conceito de grafo de tabu_search.hpp: delta e aplicação de movimentos iteram os
+// vizinhos decodificando grupo a grupo (sem buffer por linha). adjacent(u, v) decodifica a
+// linha de menor grau até passar de v (O(grau) no lugar da busca binária do CSR).
+
+#pragma once
+#include <vector>
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+#include <stdexcept>
+#include "tabu_search.hpp"
+#include "parallel.hpp"
+#if defined(__SSSE3__)
+#include <immintrin.h>
+#endif
+
+namespace tabueqcol {
+
+namespace svb {
+
+// Código de 2 bits de um valor: número de bytes - 1
+inline int code_of(uint32_t x) {
+    return x < (1u << 8) ? 0 : x < (1u << 16) ? 1 : x < (1u << 24) ? 2 : 3;
+}
+
+inline uint32_t zigzag(int32_t x) { return ((uint32_t)x << 1) ^ (uint32_t)(x >> 31); }
+inline int32_t unzigzag(uint32_t z) { return (int32_t)(z >> 1) ^ -(int32_t)(z & 1); }
+
+inline int varint_size(uint32_t x) {
+    int s = 1;
+    while (x >= 0x80) { x >>= 7; ++s; }
+    return s;
+}
+
+inline uint8_t* put_varint(uint8_t* p, uint32_t x) {
+    while (x >= 0x80) {
+        *p++ = (uint8_t)(x | 0x80);
+        x >>= 7;
+    }
+    *p++ = (uint8_t)x;
+    return p;
+}
+
+inline const uint8_t* get_varint(const uint8_t* p, uint32_t& x) {
+    x = 0;
+    for (int shift = 0;; shift += 7) {
+        uint8_t b = *p++;
+        x |= (uint32_t)(b & 0x7f) << shift;
+        if (!(b & 0x80)) return p;
+    }
+}
+
+// Bytes de dados de um grupo, por byte de controle
+struct Tables {
+    uint8_t length[256];
+    uint8_t shuffle[256][16]; // pshufb: byte j do valor i <- posição no bloco (0x80 = zero)
+
+    Tables() {
+        for (int c = 0; c < 256; ++c) {
+            int pos = 0;
+            for (int i = 0; i < 4; ++i) {
+                int len = ((c >> (2 * i)) & 3) + 1;
+                for (int j = 0; j < 4; ++j) shuffle[c][4 * i + j] = j < len ? (uint8_t)(pos + j) : 0x80;
+                pos += len;
+            }
+            length[c] = (uint8_t)pos;
+        }
+    }
+};
+
+inline const Tables& tables() {
+    static const Tables T;
+    return T;
+}
+
+} // namespace svb
+
+struct CompressedGraph {
+    static constexpr int BLOCK_SHIFT = 6;
+
+    int n = 0;
+    long long m = 0;
+    int max_degree = 0;
+    std::vector<uint64_t> block_base; // início de cada bloco de 64 linhas em bytes
+    std::vector<uint32_t> local;      // início da linha v relativo ao seu bloco
+    std::vector<uint8_t> bytes;       // grau + controle + dados de cada linha, mais 16 bytes de folga
+
+    CompressedGraph() = default;
+
+    explicit CompressedGraph(const Instance& I, int threads = 0) : n(I.n), m(I.m), max_degree(I.max_degree) {
+        encode([&](int v) { return I.adj[v]; }, threads);
+    }
+
+    // A partir da lista de arestas de I (antes de build_adj); I fica só com n, m e max_degree
+    static CompressedGraph from_edges(Instance& I, int threads = 0) {
+        CsrAdjacency raw = I.build_rows(threads);
+        CompressedGraph G;
+        G.n = I.n;
+        G.m = I.m;
+        G.max_degree = I.max_degree;
+        G.encode([&](int v) {
+            const int* first = raw.nbr.data() + raw.offset[v];
+            return NeighborRange{first, first + I.degrees[v]};
+        }, threads);
+        std::vector<int>().swap(I.degrees);
+        return G;
+    }
+
+    // Bytes que o CSR equivalente ocuparia (offsets + vizinhos + graus)
+    static long long csr_bytes(long long n, long long m) {
+        return (n + 1) * (long long)sizeof(long long) + 2 * m * (long long)sizeof(int) + n * (long long)sizeof(int);
+    }
+
+    int degree(int v) const {
+        uint32_t d;
+        svb::get_varint(row_start(v), d);
+        return (int)d;
+    }
+
+    template <class F>
+    void for_each_neighbour(int v, F&& f) const {
+        uint32_t du;
+        const uint8_t* ctrl = svb::get_varint(row_start(v), du);
+        const int d = (int)du;
+        const uint8_t* data = ctrl + (d + 3) / 4;
+        int out[4];
+        int prev = v;
+        for (int i = 0; i < d; i += 4) {
+            data = decode_group(*ctrl++, data, out, prev, i == 0);
+            prev = out[3];
+            const int cnt = std::min(4, d - i);
+            for (int j = 0; j < cnt; ++j) {
+                if (!visit_neighbour(f, out[j])) return;
+            }
+        }
+    }
+
+    // Linhas ordenadas: a decodificação da menor para assim que passa de v
+    bool adjacent(int u, int v) const {
+        if (degree(u) > degree(v)) std::swap(u, v);
+        bool found = false;
+        for_each_neighbour(u, [&](int w) {
+            found = w == v;
+            return w < v;
+        });
+        return found;
+    }
+
+    long long bytes_used() const { return vector_bytes(block_base) + vector_bytes(local) + vector_bytes(bytes); }
+
+    void memory_report(MemoryReport& R) const {
+        R.add("compressed.index", vector_bytes(block_base) + vector_bytes(local));
+        R.add("compressed.bytes", vector_bytes(bytes));
+    }
+
+private:
+    const uint8_t* row_start(int v) const {
+        return bytes.data() + block_base[v >> BLOCK_SHIFT] + local[v];
+    }
+
+    // row(v) devolve os vizinhos ordenados de v (NeighborRange)
+    // 1. tamanho de cada linha  2. soma de prefixo -> índice em blocos  3. codificação em paralelo
+    template <class Row>
+    void encode(Row row, int threads) {
+        std::vector<long long> start(n + 1, 0);
+        parallel_for(0, n, [&](long long lo, long long hi, int) {
+            for (long long v = lo; v < hi; ++v) {
+                NeighborRange r = row((int)v);
+                long long size = svb::varint_size((uint32_t)r.size()) + (r.size() + 3) / 4;
+                int prev = (int)v;
+                for (int i = 0; i < r.size(); ++i) {
+                    uint32_t g = i == 0 ? svb::zigzag(r.first[0] - (int)v) : (uint32_t)(r.first[i] - prev);
+                    size += svb::code_of(g) + 1;
+                    prev = r.first[i];
+                }
+                start[v] = size;
+            }
+        }, threads);
+        parallel_exclusive_scan(start, threads);
+
+        const int blocks = (n >> BLOCK_SHIFT) + 1;
+        block_base.assign(blocks, 0);
+        local.assign(n, 0);
+        for (int b = 0; b < blocks; ++b) block_base[b] = (uint64_t)start[std::min<long long>((long long)b << BLOCK_SHIFT, n)];
+        for (int v = 0; v < n; ++v) {
+            long long rel = start[v] - (long long)block_base[v >> BLOCK_SHIFT];
+            if (rel > (long long)UINT32_MAX) throw std::runtime_error("CompressedGraph: bloco de 64 linhas acima de 4 GB");
+            local[v] = (uint32_t)rel;
+        }
+        const long long total = start[n];
+        std::vector<long long>().swap(start);
+
+        // Folga: o decodificador vetorial sempre lê 16 bytes do grupo
+        bytes.assign(total + 16, 0);
+        parallel_for(0, n, [&](long long lo, long long hi, int) {
+            for (long long v = lo; v < hi; ++v) {
+                NeighborRange r = row((int)v);
+                uint8_t* ctrl = svb::put_varint(bytes.data() + block_base[v >> BLOCK_SHIFT] + local[v], (uint32_t)r.size());
+                uint8_t* data = ctrl + (r.size() + 3) / 4;
+                int prev = (int)v;
+                for (int i = 0; i < r.size(); ++i) {
+                    uint32_t g = i == 0 ? svb::zigzag(r.first[0] - (int)v) : (uint32_t)(r.first[i] - prev);
+                    int code = svb::code_of(g);
+                    ctrl[i >> 2] |= (uint8_t)(code << (2 * (i & 3)));
+                    memcpy(data, &g, code + 1); // little-endian
+                    data += code + 1;
+                    prev = r.first[i];
+                }
+            }
+        }, threads);
+    }
+
+    // Decodifica um grupo de 4 diferenças em out[] e devolve o início do próximo grupo.
+    // Valores além do grau (último grupo) saem com lixo e são ignorados pelo chamador.
+    static const uint8_t* decode_group(uint8_t c, const uint8_t* data, int* out, int prev, bool first) {
+        const auto& T = svb::tables();
+#if defined(__SSSE3__)
+        __m128i x = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)data),
+                                     _mm_loadu_si128((const __m128i*)T.shuffle[c]));
+        if (first) {
+            // O primeiro valor é relativo ao vértice (zigzag) e entra como base da soma
+            prev += svb::unzigzag((uint32_t)_mm_cvtsi128_si32(x));
+            x = _mm_and_si128(x, _mm_setr_epi32(0, -1, -1, -1));
+        }
+        x = _mm_add_epi32(x, _mm_slli_si128(x, 4));
+        x = _mm_add_epi32(x, _mm_slli_si128(x, 8));
+        x = _mm_add_epi32(x, _mm_set1_epi32(prev));
+        _mm_storeu_si128((__m128i*)out, x);
+#else
+        const uint8_t* p = data;
+        for (int i = 0; i < 4; ++i) {
+            int len = ((c >> (2 * i)) & 3) + 1;
+            uint32_t g = 0;
+            memcpy(&g, p, len); // little-endian
+            p += len;
+            if (i == 0 && first) prev += svb::unzigzag(g);
+            else prev += (int)g;
+            out[i] = prev;
+        }
+#endif
+        return data + T.length[c];
+    }
+};
+
+} // namespace tabueqcol
@@ -0,0 +1,132 @@
+// descent.hpp
+// C++17 header-only: método de descida em k (resolve k, tenta k-1 a partir da solução de k, ...)
+//
+// Usage example (sketch):
+//   StopCriterion stop(60);
+//   auto D = tabueqcol::run_descent(inst, config, stop, seed, max_iter);
+//   D.best.color / D.best_k / D.total_iterations
+//
+//   DescentJob<Instance> job(inst, config, seed, max_iter); // mesma descida, em fatias
+//   while (!job.step(stop, 256)) { /* outros jobs */ }
+//
+
+#pragma once
+#include "tabu_search.hpp"
+
+namespace tabueqcol {
+
+// Uma busca tabu em k: resultado de uma tentativa do perfil de factibilidade
+struct KAttempt {
+    int k = 0;
+    bool solved = false;
+    long long iterations = 0;
+    long long final_obj = 0;   // f ao fim (0 quando resolveu)
+    double seconds = 0.0;
+};
+
+template <class Graph = Instance>
+struct DescentResult {
+    int initial_k = 0;             // SI: k da construção inicial (Delta + 1)
+    int best_k = 0;                // SF: menor k resolvido
+    long long total_iterations = 0;
+    BasicSolutionManager<Graph> best; // melhor solução factível (SF)
+    std::vector<KAttempt> profile; // buscas na ordem em que terminaram
+};
+
+// Descida retomável: cada step() executa no máximo 'slice' iterações de tabu e devolve
+// true quando a descida terminou. Permite intercalar muitas descidas numa única thread.
+// A construção inicial acontece na primeira fatia (admitir o job é barato).
+template <class Graph>
+class DescentJob {
+public:
+    DescentJob(const Graph& g, TabuConfig config, int seed, long long max_iter)
+        : graph(&g), config(config), seed(seed), max_iter(max_iter) {}
+
+    bool step(const StopCriterion& stop, long long slice = std::numeric_limits<long long>::max()) {
+        if (finished) return true;
+
+        if (!started) {
+            // --- CONSTRUÇÃO INICIAL (SI) ---
+            current = BasicSolutionManager<Graph>(*graph, -1);
+            current.construct_greedy_initial(seed);
+
+            D.initial_k = current.k;
+            D.best = current;
+            D.best_k = current.k;
+            started = true;
+            if (config.metrics) config.metrics->best_k.store(D.best_k, std::memory_order_relaxed);
+        }
+
+        // --- LOOP DE DESCIDA (Descent Method) ---
+        long long budget = slice;
+        while (budget > 0) {
+            if (!running) {
+                long long remaining_iterations = max_iter - D.total_iterations;
+                if (stop.is_time_up() || remaining_iterations <= 0) {
+                    finished = true;
+                    break;
+                }
+                config.max_iter = (int)std::min<long long>(remaining_iterations, std::numeric_limits<int>::max());
+                current.begin_search(run, config, seed);
+                running = true;
+            }
+
+            int before = run.iter;
+            bool ended = current.step_search(run, config, stop, budget);
+            budget -= run.iter - before;
+            if (!ended) break; // fatia esgotada no meio da busca
+
+            running = false;
+            D.total_iterations += run.result.iterations;
+            D.profile.push_back({current.k, run.result.solved, run.result.iterations,
+                                 run.result.final_obj, run.result.search_seconds});
+
+            if (run.result.solved) {
+                // Sucesso: Salva e tenta K-1
+                D.best = current;
+                D.best_k = current.k;
+                if (config.metrics) config.metrics->best_k.store(D.best_k, std::memory_order_relaxed);
+
+                if (D.best_k == 1) { // Limite teórico
+                    finished = true;
+                    break;
+                }
+
+                BasicSolutionManager<Graph> nextS(*graph, D.best_k - 1);
+                nextS.construct_greedy_from_previous(D.best, seed);
+                current = nextS;
+            } else {
+                // Falha: Para a busca
+                finished = true;
+                break;
+            }
+        }
+        return finished;
+    }
+
+    bool done() const { return finished; }
+    DescentResult<Graph>& result() { return D; }
+
+private:
+    const Graph* graph;
+    TabuConfig config;
+    int seed;
+    long long max_iter;
+
+    DescentResult<Graph> D;
+    BasicSolutionManager<Graph> current;
+    TabuRun run;
+    bool started = false;
+    bool running = false;  // há uma busca tabu pausada em 'run'
+    bool finished = false;
+};
+
+template <class Graph>
+inline DescentResult<Graph> run_descent(const Graph& inst, TabuConfig config, const StopCriterion& stop,
+                                        int seed, long long max_iter) {
+    DescentJob<Graph> job(inst, config, seed, max_iter);
+    job.step(stop);
+    return std::move(job.result());
+}
+
+} // namespace tabueqcol
@@ -0,0 +1,529 @@
+// external.hpp
+// C++17 header-only: modo semi-externo (estado O(n) em RAM, adjacência lida do disco em passadas)
+//
+// Usage example (sketch):
+//   write_external_graph(g, "big.ecsr");             // qualquer grafo do conceito (streaming)
+//   ExternalOptions opt; opt.seed = 1;
+//   auto R = run_external_descent("big.ecsr", opt, stop);
+//   R.best_color / R.best_k / R.passes
+//
+// Formato do arquivo (binário, little-endian): cabeçalho {"EQCSR001", n, m, max_degree}
+// em int64 e, para v = 0..n-1 em ordem, o grau (int32) seguido dos vizinhos ordenados
+// (int32). Cada passada lê o arquivo do início ao fim: não há offsets nem acesso aleatório.
+//
+// Em RAM ficam só cores, melhor coloração, tamanhos das classes, o tabu por vértice
+// (última cor e passada de expiração) e pedidos de exchange pendentes, todos O(n), mais
+// os buffers de leitura e uma linha de adjacência. Uma thread lê blocos grandes à frente
+// do consumo (dois buffers), com aviso de leitura sequencial onde o sistema tem (portable.hpp).
+//
+// Numa passada, cada linha v traz os vizinhos: as contagens por cor de v saem exatas com
+// as cores atuais. Vértice em conflito:
+//   - transfer W+ -> W- que reduz conflitos é aplicado na hora (mantém a equidade);
+//   - senão, v deixa um pedido "quero ir para c" (c com menos vizinhos, platô incluído);
+//     quando a linha de um vértice u da cor c passa (nesta passada ou na seguinte) e u não
+//     piora indo para a cor de v, os dois trocam (exchange, tamanhos inalterados).
+// Com probabilidade 'noise' um transfer neutro ou pior é aceito (fuga de platôs). Uma
+// passada sem conflitos vistos e sem movimentos (nem exchanges de pedidos antigos) prova
+// que a coloração é própria.
+// A descida em k segue a do motor em memória: resolvido k, uma classe aleatória é
+// esvaziada (a última cor ocupa o lugar) e uma passada de colocação a redistribui pela
+// regra do M.
+
+#pragma once
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <random>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <stdexcept>
+#include <algorithm>
+#include "memory.hpp"
+#include "portable.hpp"
+#include "stopCriterion.hpp"
+
+namespace tabueqcol {
+
+struct ExternalHeader {
+    char magic[8] = {'E', 'Q', 'C', 'S', 'R', '0', '0', '1'};
+    int64_t n = 0;
+    int64_t m = 0;
+    int64_t max_degree = 0;
+};
+
+inline bool is_external_file(const std::string& path) {
+    return path.size() > 5 && path.compare(path.size() - 5, 5, ".ecsr") == 0;
+}
+
+// Grava qualquer grafo do conceito no formato acima, linha a linha (memória O(grau máximo)).
+// Grafos implícitos geram assim instâncias maiores que a RAM sem materializá-las.
+template <class Graph>
+inline void write_external_graph(const Graph& g, const std::string& path) {
+    FILE* f = fopen(path.c_str(), "wb");
+    if (!f) throw std::runtime_error("Cannot open external graph file for writing: " + path);
+    std::vector<char> iobuf(8 << 20);
+    setvbuf(f, iobuf.data(), _IOFBF, iobuf.size());
+
+    ExternalHeader H;
+    H.n = g.n;
+    fwrite(&H, sizeof(H), 1, f); // m e grau máximo são reescritos no fim
+
+    std::vector<int32_t> row;
+    long long half_edges = 0;
+    for (int v = 0; v < g.n; ++v) {
+        row.clear();
+        g.for_each_neighbour(v, [&](int u) { row.push_back(u); });
+        std::sort(row.begin(), row.end());
+        int32_t d = (int32_t)row.size();
+        fwrite(&d, sizeof(d), 1, f);
+        if (d > 0) fwrite(row.data(), sizeof(int32_t), row.size(), f);
+        half_edges += d;
+        H.max_degree = std::max<int64_t>(H.max_degree, d);
+    }
+    H.m = half_edges / 2;
+    bool ok = fseek(f, 0, SEEK_SET) == 0 && fwrite(&H, sizeof(H), 1, f) == 1;
+    ok = fclose(f) == 0 && ok;
+    if (!ok) throw std::runtime_error("Error writing external graph file: " + path);
+}
+
+// Leitura sequencial com uma thread de pré-busca: enquanto o consumidor percorre um
+// buffer, o outro é preenchido pelo próximo bloco do arquivo
+class ExternalReader {
+public:
+    ExternalReader(const std::string& path, size_t chunk_bytes) : file(path), chunk(std::max<size_t>(chunk_bytes, 1 << 16)) {
+        if (file.read_at(&H, sizeof(H), 0) != (long long)sizeof(H) || memcmp(H.magic, "EQCSR001", 8) != 0) {
+            throw std::runtime_error("Bad external graph header: " + path);
+        }
+        file.advise_sequential();
+        for (auto& b : buf) b.data.resize(chunk);
+    }
+
+    ~ExternalReader() {
+        stop_prefetch();
+    }
+
+    ExternalReader(const ExternalReader&) = delete;
+    ExternalReader& operator=(const ExternalReader&) = delete;
+
+    const ExternalHeader& header() const { return H; }
+
+    // Começa uma passada: reposiciona logo após o cabeçalho e dispara a pré-busca
+    void rewind() {
+        stop_prefetch();
+        for (auto& b : buf) {
+            b.size = 0;
+            b.ready = false;
+        }
+        cur = 0;
+        pos = 0;
+        file_pos = sizeof(ExternalHeader);
+        abort = false;
+        producer = std::thread([this] { prefetch_loop(); });
+    }
+
+    // Copia os próximos 'bytes' da passada; arquivo truncado é erro
+    void read(void* dst, size_t bytes) {
+        char* out = static_cast<char*>(dst);
+        while (bytes > 0) {
+            Buffer& b = buf[cur];
+            {
+                std::unique_lock<std::mutex> lk(mu);
+                cv.wait(lk, [&] { return b.ready; });
+            }
+            if (b.size == 0) throw std::runtime_error("Truncated external graph file");
+            size_t take = std::min(bytes, b.size - pos);
+            memcpy(out, b.data.data() + pos, take);
+            out += take;
+            bytes -= take;
+            pos += take;
+            if (pos == b.size) {
+                {
+                    std::lock_guard<std::mutex> lk(mu);
+                    b.ready = false;
+                }
+                cv.notify_all();
+                cur ^= 1;
+                pos = 0;
+            }
+        }
+    }
+
+    long long bytes_read() const { return total_read; }
+    long long buffer_bytes() const { return 2LL * (long long)chunk; }
+
+private:
+    struct Buffer {
+        std::vector<char> data;
+        size_t size = 0;
+        bool ready = false; // cheio (ou fim do arquivo com size == 0)
+    };
+
+    void prefetch_loop() {
+        for (int i = 0;; i ^= 1) {
+            Buffer& b = buf[i];
+            {
+                std::unique_lock<std::mutex> lk(mu);
+                cv.wait(lk, [&] { return !b.ready || abort; });
+                if (abort) return;
+            }
+            size_t got = 0;
+            while (got < chunk) {
+                long long r = file.read_at(b.data.data() + got, chunk - got, file_pos);
+                if (r <= 0) break;
+                got += (size_t)r;
+                file_pos += r;
+            }
+            total_read += (long long)got;
+            {
+                std::lock_guard<std::mutex> lk(mu);
+                b.size = got;
+                b.ready = true;
+            }
+            cv.notify_all();
+            if (got == 0) return;
+        }
+    }
+
+    void stop_prefetch() {
+        if (!producer.joinable()) return;
+        {
+            std::lock_guard<std::mutex> lk(mu);
+            abort = true;
+        }
+        cv.notify_all();
+        producer.join();
+    }
+
+    RawFile file;
+    ExternalHeader H;
+    size_t chunk;
+    Buffer buf[2];
+    int cur = 0;          // buffer em consumo
+    size_t pos = 0;       // posição dentro dele
+    long long file_pos = 0; // próxima leitura da thread
+    bool abort = false;
+    std::atomic<long long> total_read{0};
+    std::thread producer;
+    std::mutex mu;
+    std::condition_variable cv;
+};
+
+struct ExternalOptions {
+    int seed = 0;
+    size_t chunk_bytes = 8 << 20;   // bytes por leitura da pré-busca (dois buffers)
+    long long max_passes = 1000000; // passadas no total (colocação + melhoria)
+    int patience = 100;              // passadas sem melhorar os conflitos antes de desistir do k
+    double noise = 0.02;            // probabilidade de aceitar um transfer que não melhora
+    int tenure = 2;                 // passadas em que v não volta para a cor de onde saiu
+    bool verbose = false;           // uma linha por k resolvido
+};
+
+struct ExternalResult {
+    int n = 0;
+    int initial_k = 0;
+    int best_k = 0;
+    long long passes = 0;
+    long long moves = 0;
+    long long bytes_read = 0;
+    std::vector<int> best_color;
+    MemoryReport memory;            // estado em RAM do motor
+};
+
+// Conflitos exatos e equidade de uma coloração, numa passada (verificação independente)
+struct ExternalCheck {
+    long long conflicting_edges = 0;
+    int min_class = 0;
+    int max_class = 0;
+
+    bool ok() const { return conflicting_edges == 0 && max_class - min_class <= 1; }
+};
+
+inline ExternalCheck check_external(ExternalReader& R, const std::vector<int>& color, int k) {
+    ExternalCheck C;
+    const int n = (int)R.header().n;
+    std::vector<int> size(std::max(k, 1), 0);
+    std::vector<int32_t> row;
+    R.rewind();
+    long long twice = 0;
+    for (int v = 0; v < n; ++v) {
+        int32_t d;
+        R.read(&d, sizeof(d));
+        row.resize(d);
+        R.read(row.data(), (size_t)d * sizeof(int32_t));
+        if (color[v] < 0 || color[v] >= k) throw std::runtime_error("Color out of range in external check");
+        size[color[v]]++;
+        for (int u : row) twice += color[u] == color[v];
+    }
+    C.conflicting_edges = twice / 2;
+    C.min_class = *std::min_element(size.begin(), size.end());
+    C.max_class = *std::max_element(size.begin(), size.end());
+    return C;
+}
+
+class SemiExternalColoring {
+public:
+    SemiExternalColoring(const std::string& path, const ExternalOptions& opt)
+        : R(path, opt.chunk_bytes), opt(opt), rng(opt.seed) {
+        n = (int)R.header().n;
+        color.assign(n, -1);
+        tabu_color.assign(n, -1);
+        tabu_until.assign(n, 0);
+        row.reserve(R.header().max_degree);
+    }
+
+    ExternalResult run(const StopCriterion& stop) {
+        ExternalResult res;
+        res.n = n;
+        k = (int)R.header().max_degree + 1; // SI: Delta + 1, como a descida em memória
+        if (n > 0) k = std::min(k, n);
+        res.initial_k = k;
+        res.best_k = k;
+        set_k(k);
+        unplaced = n;
+
+        while (!stop.is_time_up() && res.passes < opt.max_passes) {
+            // Passadas de colocação (uma basta) e de melhoria até resolver ou estagnar
+            long long best_seen = -1;
+            int stale = 0;
+            bool solved = false;
+            while (!stop.is_time_up() && res.passes < opt.max_passes) {
+                long long moves_before = moves;
+                long long seen = pass();
+                res.passes++;
+                if (seen == 0 && unplaced == 0 && moves == moves_before) {
+                    solved = true;
+                    break;
+                }
+                if (best_seen < 0 || seen < best_seen) {
+                    best_seen = seen;
+                    stale = 0;
+                } else if (++stale >= opt.patience) {
+                    break;
+                }
+            }
+            if (!solved) break;
+
+            res.best_color = color;
+            res.best_k = k;
+            if (opt.verbose) printf("  [externo] k = %d resolvido (passada %lld)\n", k, res.passes);
+            if (k == 1) break;
+            drop_class();
+        }
+        if (res.best_color.empty()) res.best_color = color; // nenhum k fechou: coloração da última busca
+
+        res.moves = moves;
+        res.bytes_read = R.bytes_read();
+        memory_report(res.memory);
+        res.memory.add("external.best_color", vector_bytes(res.best_color));
+        return res;
+    }
+
+    void memory_report(MemoryReport& M) const {
+        M.add("external.color", vector_bytes(color));
+        M.add("external.tabu", vector_bytes(tabu_color) + vector_bytes(tabu_until));
+        M.add("external.class_size", vector_bytes(class_size) + vector_bytes(cnt));
+        long long w = vector_bytes(want);
+        for (const auto& q : want) w += vector_bytes(q);
+        M.add("external.requests", w);
+        M.add("external.row", vector_bytes(row));
+        M.add("external.read_buffers", R.buffer_bytes());
+    }
+
+    ExternalReader& reader() { return R; }
+
+private:
+    struct Request {
+        int v;
+        int from;
+        int pass;
+    };
+
+    void set_k(int new_k) {
+        k = new_k;
+        floor_size = n / k;
+        class_size.assign(k, 0);
+        cnt.assign(k, 0);
+        want.assign(k, {});
+    }
+
+    // Regra do M: classes grandes (floor + 1) só até completar r = n mod k delas
+    int max_allowed() const { return big_classes < n - k * floor_size ? floor_size + 1 : floor_size; }
+
+    void place(int v, int c) {
+        if (class_size[c] == floor_size) big_classes++;
+        class_size[c]++;
+        color[v] = c;
+        unplaced--;
+    }
+
+    // Uma passada completa pelo arquivo; devolve os conflitos vistos (cada aresta conta 2x)
+    long long pass() {
+        long long seen = 0;
+        const bool transfers = n % k != 0;
+        R.rewind();
+        cur_pass++;
+        for (int v = 0; v < n; ++v) {
+            int32_t d;
+            R.read(&d, sizeof(d));
+            row.resize(d);
+            R.read(row.data(), (size_t)d * sizeof(int32_t));
+
+            // Contagens por cor dos vizinhos (só as cores tocadas são zeradas depois)
+            touched.clear();
+            for (int u : row) {
+                int c = color[u];
+                if (c < 0) continue;
+                if (cnt[c]++ == 0) touched.push_back(c);
+            }
+
+            if (color[v] < 0) {
+                // Colocação: menor classe permitida sem vizinhos, senão uma permitida ao acaso
+                int M = max_allowed();
+                int chosen = -1, fallback = -1, options = 0;
+                for (int c = 0; c < k; ++c) {
+                    if (class_size[c] > M - 1) continue;
+                    if (cnt[c] == 0) {
+                        chosen = c;
+                        break;
+                    }
+                    if (rng() % (unsigned)++options == 0) fallback = c;
+                }
+                place(v, chosen >= 0 ? chosen : fallback);
+                seen += 2 * (long long)cnt[color[v]]; // arestas com vizinhos já colocados
+            } else {
+                const int cv = color[v];
+                const int own = cnt[cv];
+                seen += own;
+                if (own > 0) improve(v, own, transfers);
+                else serve_request(v);
+            }
+            for (int c : touched) cnt[c] = 0;
+        }
+        return seen;
+    }
+
+    bool is_tabu(int v, int c) const { return tabu_color[v] == c && tabu_until[v] >= cur_pass; }
+
+    void move(int v, int c) {
+        tabu_color[v] = color[v];
+        tabu_until[v] = cur_pass + opt.tenure;
+        color[v] = c;
+        moves++;
+    }
+
+    // v em conflito: transfer que melhora, exchange com um pedido pendente ou novo pedido
+    void improve(int v, int own, bool transfers) {
+        const int cv = color[v];
+        std::uniform_real_distribution<double> U(0.0, 1.0);
+
+        if (transfers && class_size[cv] == floor_size + 1) {
+            int best = -1, best_cnt = INT32_MAX, ties = 0;
+            for (int c = 0; c < k; ++c) {
+                if (c == cv || class_size[c] != floor_size || is_tabu(v, c)) continue;
+                if (cnt[c] < best_cnt) {
+                    best = c;
+                    best_cnt = cnt[c];
+                    ties = 1;
+                } else if (cnt[c] == best_cnt && rng() % (unsigned)++ties == 0) {
+                    best = c;
+                }
+            }
+            if (best >= 0 && (best_cnt < own || U(rng) < opt.noise)) {
+                class_size[cv]--;
+                class_size[best]++;
+                move(v, best);
+                return;
+            }
+        }
+
+        if (serve_request(v)) return;
+
+        // Pedido para a cor com menos vizinhos (sorteio entre empates). Platôs também
+        // viram pedido (o tabu evita o vaivém); piora só com probabilidade 'noise'
+        int target = -1, target_cnt = INT32_MAX, ties = 0;
+        for (int c = 0; c < k; ++c) {
+            if (c == cv || is_tabu(v, c)) continue;
+            if (cnt[c] < target_cnt) {
+                target = c;
+                target_cnt = cnt[c];
+                ties = 1;
+            } else if (cnt[c] == target_cnt && rng() % (unsigned)++ties == 0) {
+                target = c;
+            }
+        }
+        if (target >= 0 && (target_cnt <= own || U(rng) < opt.noise)) want[target].push_back({v, cv, cur_pass});
+    }
+
+    // u (com a linha em mãos) troca com um pedido pendente para a sua cor se não piorar
+    bool serve_request(int u) {
+        const int cu = color[u];
+        auto& q = want[cu];
+        while (!q.empty()) {
+            Request r = q.back();
+            if (r.pass < cur_pass - 1 || color[r.v] != r.from || r.v == u) {
+                q.pop_back(); // obsoleto: v já saiu da cor ou o pedido expirou
+                continue;
+            }
+            if (cnt[r.from] > cnt[cu] || is_tabu(u, r.from)) return false;
+            q.pop_back();
+            move(u, r.from);
+            move(r.v, cu);
+            return true;
+        }
+        return false;
+    }
+
+    // Descida: esvazia uma classe ao acaso, a última cor ocupa o lugar dela
+    void drop_class() {
+        int removed = (int)(rng() % (unsigned)k);
+        for (int v = 0; v < n; ++v) {
+            if (color[v] == removed) color[v] = -1;
+            else if (color[v] == k - 1) color[v] = removed;
+        }
+        std::vector<int> size(k - 1, 0);
+        for (int v = 0; v < n; ++v) {
+            if (color[v] >= 0) size[color[v]]++;
+        }
+        set_k(k - 1);
+        unplaced = 0;
+        big_classes = 0;
+        for (int c = 0; c < k; ++c) {
+            class_size[c] = size[c];
+            if (size[c] > floor_size) big_classes++;
+        }
+        for (int v = 0; v < n; ++v) unplaced += color[v] < 0;
+        std::fill(tabu_color.begin(), tabu_color.end(), -1);
+    }
+
+    ExternalReader R;
+    ExternalOptions opt;
+    std::mt19937 rng;
+
+    int n = 0;
+    int k = 0;
+    int floor_size = 0;
+    int big_classes = 0;            // classes com floor + 1 vértices
+    int unplaced = 0;               // vértices sem cor (construção e após esvaziar uma classe)
+    int cur_pass = 0;
+    long long moves = 0;
+
+    std::vector<int> color;
+    std::vector<int> class_size;
+    std::vector<int> tabu_color;    // cor de onde v saiu por último
+    std::vector<int> tabu_until;    // passada até a qual v não volta para ela
+    std::vector<std::vector<Request>> want; // want[c]: vértices em conflito que querem ir para c
+    std::vector<int> cnt;           // vizinhos por cor da linha atual
+    std::vector<int> touched;
+    std::vector<int32_t> row;
+};
+
+inline ExternalResult run_external_descent(const std::string& path, const ExternalOptions& opt, const StopCriterion& stop) {
+    SemiExternalColoring S(path, opt);
+    return S.run(stop);
+}
+
+} // namespace tabueqcol
@@ -0,0 +1,291 @@
+// implicit_graphs.hpp
+// C++17 header-only: famílias de grafos definidas por regra (sem materializar a adjacência)
+//
+// Cada tipo segue o conceito de grafo de tabu_search.hpp (n, max_degree, degree(v),
+// for_each_neighbour(v, f), adjacent(u, v)) e usa memória O(n). Vizinhos são calculados
+// sob demanda, então BasicSolutionManager<G> roda sem nenhuma lista de adjacência.
+//
+// Especificações aceitas no lugar do arquivo de instância:
+//   kneser:N:K                      grafo de Kneser K(N,K) (subconjuntos disjuntos), N <= 62
+//   geometric:n:r[:seed]            grafo geométrico aleatório no quadrado unitário, raio r
+//   interval:n:span:maxlen[:seed]   grafo de interseção de intervalos aleatórios em [0, span)
+//
+
+#pragma once
+#include <vector>
+#include <string>
+#include <sstream>
+#include <random>
+#include <cmath>
+#include <cstdint>
+#include <algorithm>
+#include <numeric>
+#include <stdexcept>
+#include "tabu_search.hpp"
+#include "parallel.hpp"
+
+namespace tabueqcol {
+
+// "tipo:a:b:c" -> {"tipo","a","b","c"}
+inline std::vector<std::string> split_spec(const std::string& spec) {
+    std::vector<std::string> parts;
+    std::stringstream ss(spec);
+    std::string item;
+    while (std::getline(ss, item, ':')) parts.push_back(item);
+    return parts;
+}
+
+inline bool is_implicit_spec(const std::string& s) {
+    return s.rfind("kneser:", 0) == 0 || s.rfind("geometric:", 0) == 0 || s.rfind("interval:", 0) == 0;
+}
+
+// ------------------ Kneser K(N,K) ------------------
+// Vértices: subconjuntos de tamanho K de {0..N-1} (bitmask), numerados em ordem colex.
+// u ~ v sse os subconjuntos são disjuntos. Grau constante C(N-K, K).
+struct KneserGraph {
+    int n = 0;
+    int max_degree = 0;
+    int N = 0, K = 0;
+    std::vector<uint64_t> mask;                  // mask[v]
+    std::vector<std::vector<long long>> binom;   // binom[a][b] = C(a, b)
+
+    KneserGraph(int N_, int K_) : N(N_), K(K_) {
+        if (N < 1 || N > 62 || K < 1 || 2 * K > N)
+            throw std::runtime_error("Kneser graph needs 1 <= K, 2K <= N <= 62");
+
+        binom.assign(N + 1, std::vector<long long>(K + 1, 0));
+        for (int a = 0; a <= N; ++a) {
+            binom[a][0] = 1;
+            for (int b = 1; b <= std::min(a, K); ++b)
+                binom[a][b] = binom[a - 1][b - 1] + (b <= a - 1 ? binom[a - 1][b] : 0);
+        }
+        if (binom[N][K] > std::numeric_limits<int>::max())
+            throw std::runtime_error("Kneser graph too large for int vertex ids");
+
+        n = (int)binom[N][K];
+        max_degree = (int)binom[N - K][K];
+
+        // Enumera os K-subconjuntos em ordem colex (Gosper) -> rank(mask[v]) == v
+        mask.resize(n);
+        uint64_t x = (1ULL << K) - 1;
+        for (int v = 0; v < n; ++v) {
+            mask[v] = x;
+            uint64_t c = x & (~x + 1), r = x + c;
+            x = (((r ^ x) >> 2) / c) | r;
+        }
+    }
+
+    static KneserGraph from_spec(const std::string& spec) {
+        auto p = split_spec(spec);
+        if (p.size() != 3) throw std::runtime_error("Expected kneser:N:K");
+        return KneserGraph(std::stoi(p[1]), std::stoi(p[2]));
+    }
+
+    int degree(int) const { return max_degree; }
+
+    bool adjacent(int u, int v) const { return (mask[u] & mask[v]) == 0; }
+
+    void memory_report(MemoryReport& R) const {
+        R.add("kneser.mask", vector_bytes(mask));
+        R.add("kneser.binom", vector_bytes(binom));
+    }
+
+    // Enumera os K-subconjuntos do complemento de mask[v]; o rank colex é acumulado
+    // incrementalmente: rank = sum_i C(pos_i, i+1) com pos_0 < pos_1 < ...
+    template <class F>
+    void for_each_neighbour(int v, F&& f) const {
+        int pos[64];
+        int L = 0;
+        uint64_t comp = ~mask[v] & ((N == 64) ? ~0ULL : ((1ULL << N) - 1));
+        while (comp) {
+            pos[L++] = ctz64(comp);
+            comp &= comp - 1;
+        }
+
+        int c[64];
+        for (int i = 0; i < K; ++i) c[i] = i;
+        while (true) {
+            long long r = 0;
+            for (int i = 0; i < K; ++i) r += binom[pos[c[i]]][i + 1];
+            if (!visit_neighbour(f, (int)r)) return;
+
+            // Próxima combinação de índices em [0, L)
+            int i = K - 1;
+            while (i >= 0 && c[i] == L - K + i) --i;
+            if (i < 0) return;
+            ++c[i];
+            for (int j = i + 1; j < K; ++j) c[j] = c[j - 1] + 1;
+        }
+    }
+};
+
+// ------------------ Geométrico aleatório ------------------
+// n pontos uniformes em [0,1)^2; u ~ v sse dist(u,v) <= r.
+// Grade espacial com células de lado >= r: vizinhos estão nas 3x3 células ao redor.
+// Os vértices são renumerados na ordem das células (localidade de memória).
+struct GeometricGraph {
+    int n = 0;
+    int max_degree = 0;
+    double r = 0.0;
+    int g = 1;                          // células por lado
+    std::vector<double> x, y;           // coordenadas (ordem das células)
+    std::vector<int> cell_start;        // g*g + 1
+    std::vector<int> degrees;           // cache O(n)
+
+    GeometricGraph(int n_, double r_, int seed = 0) : n(n_), r(r_) {
+        if (n < 1 || r <= 0) throw std::runtime_error("Geometric graph needs n >= 1 and r > 0");
+
+        // g <= 1/r garante célula >= r; o teto sqrt(2n) limita a memória da grade
+        g = (int)std::max(1.0, std::min(std::floor(1.0 / r), std::floor(std::sqrt(2.0 * n))));
+
+        std::mt19937_64 rng(seed);
+        std::uniform_real_distribution<double> U(0.0, 1.0);
+        std::vector<double> px(n), py(n);
+        std::vector<int> cell(n);
+        for (int i = 0; i < n; ++i) {
+            px[i] = U(rng);
+            py[i] = U(rng);
+            cell[i] = cell_of(px[i], py[i]);
+        }
+
+        // Counting sort pelas células
+        cell_start.assign((size_t)g * g + 1, 0);
+        for (int i = 0; i < n; ++i) cell_start[cell[i]]++;
+        parallel_exclusive_scan(cell_start);
+        std::vector<int> fill(cell_start.begin(), cell_start.end() - 1);
+        x.resize(n);
+        y.resize(n);
+        for (int i = 0; i < n; ++i) {
+            int p = fill[cell[i]]++;
+            x[p] = px[i];
+            y[p] = py[i];
+        }
+
+        degrees.assign(n, 0);
+        parallel_for(0, n, [&](long long lo, long long hi, int) {
+            for (long long v = lo; v < hi; ++v) {
+                int d = 0;
+                for_each_neighbour((int)v, [&](int) { ++d; });
+                degrees[v] = d;
+            }
+        });
+        max_degree = n > 0 ? *std::max_element(degrees.begin(), degrees.end()) : 0;
+    }
+
+    static GeometricGraph from_spec(const std::string& spec) {
+        auto p = split_spec(spec);
+        if (p.size() != 3 && p.size() != 4) throw std::runtime_error("Expected geometric:n:r[:seed]");
+        return GeometricGraph(std::stoi(p[1]), std::stod(p[2]), p.size() == 4 ? std::stoi(p[3]) : 0);
+    }
+
+    int cell_of(double px, double py) const {
+        int cx = std::min(g - 1, (int)(px * g));
+        int cy = std::min(g - 1, (int)(py * g));
+        return cy * g + cx;
+    }
+
+    int degree(int v) const { return degrees[v]; }
+
+    bool adjacent(int u, int v) const {
+        if (u == v) return false;
+        double dx = x[u] - x[v], dy = y[u] - y[v];
+        return dx * dx + dy * dy <= r * r;
+    }
+
+    void memory_report(MemoryReport& R) const {
+        R.add("geometric.coords", vector_bytes(x) + vector_bytes(y));
+        R.add("geometric.cell_start", vector_bytes(cell_start));
+        R.add("geometric.degrees", vector_bytes(degrees));
+    }
+
+    template <class F>
+    void for_each_neighbour(int v, F&& f) const {
+        int cx = std::min(g - 1, (int)(x[v] * g));
+        int cy = std::min(g - 1, (int)(y[v] * g));
+        const double r2 = r * r;
+        for (int yy = std::max(0, cy - 1); yy <= std::min(g - 1, cy + 1); ++yy) {
+            for (int xx = std::max(0, cx - 1); xx <= std::min(g - 1, cx + 1); ++xx) {
+                int c = yy * g + xx;
+                for (int u = cell_start[c]; u < cell_start[c + 1]; ++u) {
+                    if (u == v) continue;
+                    double dx = x[u] - x[v], dy = y[u] - y[v];
+                    if (dx * dx + dy * dy <= r2) {
+                        if (!visit_neighbour(f, u)) return;
+                    }
+                }
+            }
+        }
+    }
+};
+
+// ------------------ Interseção de intervalos ------------------
+// n intervalos abertos (l, l + len), l uniforme em [0, span), len uniforme em [0, maxlen].
+// u ~ v sse os intervalos se sobrepõem. Ordenados por l: os vizinhos de v estão na janela
+// l in (l_v - maxlen, r_v), localizada por busca binária.
+struct IntervalGraph {
+    int n = 0;
+    int max_degree = 0;
+    double maxlen = 0.0;
+    std::vector<double> left, right;  // ordenados por left
+    std::vector<int> degrees;         // cache O(n)
+
+    IntervalGraph(int n_, double span, double maxlen_, int seed = 0) : n(n_), maxlen(maxlen_) {
+        if (n < 1 || span <= 0 || maxlen < 0) throw std::runtime_error("Interval graph needs n >= 1, span > 0, maxlen >= 0");
+
+        std::mt19937_64 rng(seed);
+        std::uniform_real_distribution<double> L(0.0, span), W(0.0, maxlen);
+        std::vector<std::pair<double,double>> iv(n);
+        for (auto &p : iv) {
+            p.first = L(rng);
+            p.second = p.first + W(rng);
+        }
+        std::sort(iv.begin(), iv.end());
+        left.resize(n);
+        right.resize(n);
+        for (int i = 0; i < n; ++i) {
+            left[i] = iv[i].first;
+            right[i] = iv[i].second;
+        }
+
+        degrees.assign(n, 0);
+        parallel_for(0, n, [&](long long lo, long long hi, int) {
+            for (long long v = lo; v < hi; ++v) {
+                int d = 0;
+                for_each_neighbour((int)v, [&](int) { ++d; });
+                degrees[v] = d;
+            }
+        });
+        max_degree = *std::max_element(degrees.begin(), degrees.end());
+    }
+
+    static IntervalGraph from_spec(const std::string& spec) {
+        auto p = split_spec(spec);
+        if (p.size() != 4 && p.size() != 5) throw std::runtime_error("Expected interval:n:span:maxlen[:seed]");
+        return IntervalGraph(std::stoi(p[1]), std::stod(p[2]), std::stod(p[3]), p.size() == 5 ? std::stoi(p[4]) : 0);
+    }
+
+    int degree(int v) const { return degrees[v]; }
+
+    bool adjacent(int u, int v) const {
+        return u != v && left[u] < right[v] && left[v] < right[u];
+    }
+
+    void memory_report(MemoryReport& R) const {
+        R.add("interval.endpoints", vector_bytes(left) + vector_bytes(right));
+        R.add("interval.degrees", vector_bytes(degrees));
+    }
+
+    // Vizinhos em ordem crescente de id
+    template <class F>
+    void for_each_neighbour(int v, F&& f) const {
+        int u = (int)(std::upper_bound(left.begin(), left.end(), left[v] - maxlen) - left.begin());
+        for (; u < n && left[u] < right[v]; ++u) {
+            if (u == v) continue;
+            if (left[v] < right[u]) {
+                if (!visit_neighbour(f, u)) return;
+            }
+        }
+    }
+};
+
+} // namespace tabueqcol
@@ -0,0 +1,99 @@
+// instance_io.hpp
+// C++17 header-only: leitura de instâncias e leitura/escrita de colorações
+//
+// Formato da instância (1-based; o arquivo pode vir comprimido com gzip ou zstd):
+//   n m
+//   a1 b1
+//   ...
+//
+// Formato da coloração (1-based, uma linha por vértice):
+//   n k
+//   v cor
+//   ...
+//
+
+#pragma once
+#include <string>
+#include <vector>
+#include <fstream>
+#include <stdexcept>
+#include "tabu_search.hpp"
+#include "stream_input.hpp"
+
+namespace tabueqcol {
+
+// Aceita o arquivo em texto puro, gzip ou zstd (stream_input.hpp): a descompressão roda
+// numa thread própria, sobreposta ao parsing, e nada é descomprimido em disco.
+// build = false devolve só a lista de arestas (with_storage monta a representação)
+inline Instance read_instance(const std::string &path, bool build = true) {
+    TokenStream in(path);
+
+    Instance I;
+    long long n, kpairs;
+
+    if (!in.next(n) || !in.next(kpairs)) throw std::runtime_error("Bad instance header");
+    I.n = (int)n;
+
+    I.edges.reserve(kpairs);
+
+    for (long long t = 0; t < kpairs; ++t) {
+        long long a, b;
+        if (!in.next(a) || !in.next(b)) throw std::runtime_error("Truncated instance file: " + path);
+        // Assume input 1-based -> converte para 0-based aqui
+        I.edges.emplace_back((int)a - 1, (int)b - 1);
+    }
+
+    if (build) I.build_adj();
+
+    return I;
+}
+
+// Só o cabeçalho "n m": permite estimar a memória antes de construir o grafo
+inline void read_instance_header(const std::string &path, long long& n, long long& m) {
+    TokenStream in(path, 1 << 16, 2);
+    if (!in.next(n) || !in.next(m)) throw std::runtime_error("Bad instance header");
+}
+
+// Grava a instância no mesmo formato de leitura (usa o CSR: cada aresta uma vez)
+inline void write_instance(const std::string &path, const Instance& I) {
+    std::ofstream out(path);
+    if (!out) throw std::runtime_error("Cannot open instance file for writing: " + path);
+
+    out << I.n << " " << I.m << "\n";
+    for (int v = 0; v < I.n; ++v) {
+        for (int u : I.adj[v]) {
+            if (u > v) out << (v + 1) << " " << (u + 1) << "\n";
+        }
+    }
+}
+
+// Grava color[] (0-based internamente) no formato 1-based acima
+inline void write_coloring(const std::string &path, const std::vector<int>& color, int k) {
+    std::ofstream out(path);
+    if (!out) throw std::runtime_error("Cannot open coloring file for writing: " + path);
+
+    out << color.size() << " " << k << "\n";
+    for (size_t v = 0; v < color.size(); ++v) {
+        out << (v + 1) << " " << (color[v] + 1) << "\n";
+    }
+}
+
+// Lê uma coloração; vértices ausentes ficam com cor -1 (o verificador acusa)
+inline std::vector<int> read_coloring(const std::string &path, int* k_out = nullptr) {
+    std::ifstream in(path);
+    if (!in) throw std::runtime_error("Cannot open coloring file: " + path);
+
+    int n, k;
+    if (!(in >> n >> k)) throw std::runtime_error("Bad coloring header");
+    if (k_out) *k_out = k;
+
+    std::vector<int> color(n, -1);
+    int v, c;
+    while (in >> v >> c) {
+        if (v < 1 || v > n) throw std::runtime_error("Vertex out of range in coloring: " + std::to_string(v));
+        color[v - 1] = c - 1;
+    }
+    return color;
+}
+
+} // namespace tabueqcol
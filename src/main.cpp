@@ -5,172 +5,619 @@
 
 #include "args.hpp"
 #include "tabu_search.hpp"
+#include "instance_io.hpp"
+#include "verify.hpp"
+#include "descent.hpp"
+#include "implicit_graphs.hpp"
+#include "compressed_graph.hpp"
+#include "storage.hpp"
+#include "autotune.hpp"
+#include "scheduler.hpp"
+#include "components.hpp"
+#include "portfolio.hpp"
+#include "probing.hpp"
+#include "recombination.hpp"
+#include "online.hpp"
+#include "external.hpp"
 #include <iostream>
 #include <fstream>
 #include <vector>
 #include <utility>
+#include <mutex>
+#include <algorithm>
 
 using namespace std;
 
 
 
 
-static void die(const string &msg);
-tabueqcol::Instance read_instance(const string &path);
 
 
 
 #include <fstream>  // Necessário para arquivos
 #include <iomanip>  // Necessário para formatação
 
-int main(int argc, char** argv) {
-    try {
-        Arguments args = parse_arguments(argc, argv);
+// Acrescenta uma linha de resultados ao CSV (cria o cabeçalho se o arquivo for novo)
+static bool append_csv_line(const std::string& output_file, const std::string& instance, int seed,
+                            const TabuConfig& tabuConfig, int initial_k, int best_k_found,
+                            double dev_percent, double total_time, long long total_iterations,
+                            const std::string& kernel) {
+    // Abre em modo APPEND para não sobrescrever testes anteriores
+    std::ofstream outfile(output_file, std::ios::app);
+    
+    if (outfile.is_open()) {
+        // Se arquivo for novo/vazio, escreve cabeçalho COMPLETO
+        // Incluindo os parâmetros do teste para análise posterior
+        outfile.seekp(0, std::ios::end);
+        if (outfile.tellp() == 0) {
+            outfile << "Instance;Seed;"
+                    << "Alpha;Beta;P_Limit;P_Str;Asp;" // Parâmetros do Teste
+                    << "SI;SF;Dev(%);Time(s);TotalIter;" // Resultados
+                    << "Kernel\n"; // Kernel usado (autotune ou linha de comando)
+        }
 
-        // --- LEITURA DA INSTÂNCIA ---
-        // printf("Lendo instancia: %s\n", args.input_file.c_str());
-        const tabueqcol::Instance inst = read_instance(args.input_file);
-        
-        // --- CONFIGURAÇÃO ---
-        StopCriterion globalStop(args.time_limit);
+        // Escreve linha de dados
+        outfile << instance << ";" 
+                << seed << ";"
+                // Parâmetros usados neste teste
+                << tabuConfig.alpha << ";"
+                << tabuConfig.beta << ";"
+                << tabuConfig.perturbation_limit << ";"
+                << tabuConfig.perturbation_strength << ";"
+                << tabuConfig.aspiration << ";"
+                // Resultados
+                << initial_k << ";" 
+                << best_k_found << ";" 
+                << std::fixed << std::setprecision(2) << dev_percent << ";" 
+                << std::fixed << std::setprecision(4) << total_time << ";" 
+                << total_iterations << ";"
+                << kernel << "\n";
         
-        TabuConfig tabuConfig;
-        tabuConfig.max_iter = args.max_iter;
-        tabuConfig.alpha = args.alpha;
-        tabuConfig.beta = (int)args.beta;
-        tabuConfig.perturbation_limit = args.perturbation_limit;
-        tabuConfig.aspiration = args.aspiration;
-        tabuConfig.perturbation_strength = args.perturbation_strength;
-
-        printf("Alpha: %.2f | Beta: %d | P_Limit: %d | Asp: %d\n", tabuConfig.alpha, tabuConfig.beta, tabuConfig.perturbation_limit, tabuConfig.aspiration);
-
-        // --- CONSTRUÇÃO INICIAL (SI) ---
-        // printf("Gerando solucao inicial...\n");
-        tabueqcol::SolutionManager currentS(inst, -1); 
-        currentS.construct_greedy_initial(args.seed);
-
-        // Variáveis para Estatísticas
-        int initial_k = currentS.k;
-        long long total_iterations = 0;
-        
-        // Melhor Solução (SF)
-        tabueqcol::SolutionManager bestFeasibleS = currentS; 
-        int best_k_found = currentS.k;
-
-        // printf("Iniciando busca. K_ini=%d. TimeLimit=%.2fs\n", initial_k, args.time_limit);
-
-        // --- LOOP DE DESCIDA (Descent Method) ---
-        while (!globalStop.is_time_up()) {
-            long long remaining_iterations = args.max_iter - total_iterations;
-            if (remaining_iterations <= 0) break;
-
-            tabuConfig.max_iter = remaining_iterations;
-            auto result = currentS.run_tabu_search(tabuConfig, globalStop, args.seed);
-            total_iterations += result.iterations;
-
-            if (result.solved) {
-                // Sucesso: Salva e tenta K-1
-                // printf("  [%.2fs] K=%d resolvido (%d iter)\n", globalStop.get_elapsed(), currentS.k, result.iterations);
-                
-                bestFeasibleS = currentS; 
-                best_k_found = currentS.k;
-
-                if (best_k_found == 1) break; // Limite teórico
-
-                int next_k = best_k_found - 1;
-                tabueqcol::SolutionManager nextS(inst, next_k);
-                nextS.construct_greedy_from_previous(bestFeasibleS, args.seed);
-                currentS = nextS; 
-            } else {
-                // Falha: Para a busca
-                // printf("  [STOP] Falha em K=%d\n", currentS.k);
-                break;
+        outfile.close();
+        return true;
+    }
+    std::cerr << "ERRO: Nao foi possivel escrever em " << output_file << "\n";
+    return false;
+}
+
+// Descida completa + relatório, para qualquer tipo de grafo (Instance ou implícito)
+template <class Graph>
+static int solve(const Graph& inst, const Arguments& args, const TabuConfig& tabuConfig,
+                 const StopCriterion& globalStop, const std::string& kernel,
+                 const tabueqcol::ComponentSplit* split = nullptr) {
+    printf("Alpha: %.2f | Beta: %d | P_Limit: %d | Asp: %d\n", tabuConfig.alpha, tabuConfig.beta, tabuConfig.perturbation_limit, tabuConfig.aspiration);
+    if (tabuConfig.scan_mode == 1) {
+        printf("Scan: amostrada (vertices %d | classes %d | parceiros %d | adapt %d)\n",
+               tabuConfig.sample_vertices, tabuConfig.sample_classes, tabuConfig.sample_partners, tabuConfig.sample_adapt);
+    } else if (tabuConfig.scan_mode == 2) {
+        printf("Scan: first improvement (orçamento %lld)\n", tabuConfig.first_budget);
+    }
+
+    // --- DESCIDA EM K (SI -> SF) ---
+    // Com --mem_report, cada busca deixa o seu retrato antes de liberar as estruturas
+    tabueqcol::PeakMemoryReport search_peak;
+    TabuConfig searchConfig = tabuConfig;
+    if (args.mem_report) searchConfig.memory_peak = &search_peak;
+    // Grafo desconexo: uma descida por componente + recombinação (ver components.hpp)
+    auto descent = [&]() {
+        if (args.portfolio) {
+            // Portfólio: motores em paralelo sobre o mesmo grafo, k compartilhado
+            auto P = tabueqcol::run_portfolio(inst, searchConfig, globalStop, args.seed, args.max_iter, args.threads, args.slice);
+            for (const auto& e : P.engines) {
+                printf("  [portfolio] %-8s fatias %8lld | iteracoes %10lld | tentativas %5d | ks fechados %3d | credito %.2f\n",
+                       e.name.c_str(), e.slices, e.iterations, e.attempts, e.wins, e.score);
             }
+            return std::move(P.descent);
+        }
+        if constexpr (std::is_same_v<Graph, tabueqcol::Instance>) {
+            if (split) {
+                return tabueqcol::run_component_descent(inst, *split, searchConfig, globalStop, args.seed, args.max_iter, args.threads);
+            }
+        }
+        if (args.probe_depth > 0) {
+            // Não monótono: continua sondando abaixo da primeira falha
+            return tabueqcol::run_probing_descent(inst, searchConfig, globalStop, args.seed, args.max_iter,
+                                                  args.probe_depth, args.threads);
+        }
+        if (args.class_pool > 0) {
+            // Pool de classes: recombinação por particionamento de conjuntos após a primeira falha
+            auto P = tabueqcol::run_pool_descent(inst, searchConfig, globalStop, args.seed, args.max_iter, args.class_pool);
+            printf("Pool: %zu classes | recombinacoes %d | exatas %d | ks fechados %d\n",
+                   P.pool_classes, P.partitions, P.exact, P.closed);
+            return std::move(P.descent);
+        }
+        return tabueqcol::run_descent(inst, searchConfig, globalStop, args.seed, args.max_iter);
+    }();
+
+    if (args.probe_depth > 0 || args.class_pool > 0 || split) {
+        printf("Perfil de factibilidade:\n");
+        for (const auto& p : tabueqcol::feasibility_profile(descent)) {
+            printf("  [perfil] k %4d | %-9s | tentativas %3d | iteracoes %10lld | melhor f %lld\n",
+                   p.k, p.solved ? "resolvido" : "falhou", p.attempts, p.iterations, p.best_obj);
+        }
+    }
+
+    // Variáveis para Estatísticas
+    int initial_k = descent.initial_k;
+    long long total_iterations = descent.total_iterations;
+
+    // Melhor Solução (SF)
+    const auto& bestFeasibleS = descent.best;
+    int best_k_found = descent.best_k;
+
+    if (args.mem_report) {
+        // RSS depois da descida (o pico fica em VmHWM); estruturas no pico da busca mais cara
+        tabueqcol::report_phase("busca");
+        tabueqcol::MemoryReport R;
+        inst.memory_report(R);
+        bestFeasibleS.memory_report(R, "best.");
+        for (const auto& it : search_peak.snapshot().items) R.add(it.name, it.bytes);
+        R.print(stdout);
+    }
+
+    // --- CÁLCULOS FINAIS ---
+    double dev_percent = 0.0;
+    if (initial_k > 0) {
+        dev_percent = 100.0 * (double)(initial_k - best_k_found) / (double)initial_k;
+    }
+    double total_time = globalStop.get_elapsed();
+
+    // --- GRAVAÇÃO CSV ---
+    if (!append_csv_line(args.output_file, args.input_file, args.seed, tabuConfig,
+                         initial_k, best_k_found, dev_percent, total_time, total_iterations, kernel)) {
+        return 1;
+    }
+
+    // --- VERIFICAÇÃO E GRAVAÇÃO DA SOLUÇÃO ---
+    if (!args.solution_file.empty()) {
+        auto rep = tabueqcol::verify_coloring(inst, bestFeasibleS.color, bestFeasibleS.k);
+        if (!rep.ok()) {
+            std::cerr << "ERRO: solucao final nao passou na verificacao:\n";
+            for (auto &viol : rep.violations) std::cerr << "  " << viol.describe() << "\n";
+            return 1;
         }
+        tabueqcol::write_coloring(args.solution_file, bestFeasibleS.color, bestFeasibleS.k);
+    }
 
-        // --- CÁLCULOS FINAIS ---
-        double dev_percent = 0.0;
-        if (initial_k > 0) {
-            dev_percent = 100.0 * (double)(initial_k - best_k_found) / (double)initial_k;
+    // Output mínimo no console só para debug visual
+    printf("=== RESULTADO FINAL ===\n");
+    printf("FIM: %s | K %d->%d | Seed %d | Tempo %.4fs | Iterações %lld\n", args.input_file.c_str(), initial_k, best_k_found, args.seed, total_time, total_iterations);
+    printf("Kernel: %s\n", kernel.c_str());
+    if (args.budget != BUDGET_WALL) {
+        printf("Orcamento: %.4f de %.4f %s | Trabalho %lld unidades\n", globalStop.get_used(), args.budget_limit,
+               args.budget == BUDGET_WORK ? "unidades" : "s de CPU", globalStop.get_work());
+    }
+    return 0;
+}
+
+// Parâmetros da busca vindos da linha de comando
+static TabuConfig make_config(const Arguments& args) {
+    TabuConfig tabuConfig;
+    tabuConfig.max_iter = args.max_iter;
+    tabuConfig.alpha = args.alpha;
+    tabuConfig.beta = (int)args.beta;
+    tabuConfig.perturbation_limit = args.perturbation_limit;
+    tabuConfig.aspiration = args.aspiration;
+    tabuConfig.perturbation_strength = args.perturbation_strength;
+    tabuConfig.chain_moves = args.chain_moves;
+    tabuConfig.scan_mode = args.scan_mode;
+    tabuConfig.sample_vertices = std::max(1, args.sample_vertices);
+    tabuConfig.sample_classes = std::max(1, args.sample_classes);
+    tabuConfig.sample_partners = std::max(1, args.sample_partners);
+    tabuConfig.sample_adapt = args.sample_adapt;
+    tabuConfig.first_budget = args.first_budget;
+    return tabuConfig;
+}
+
+static void print_autotune(const tabueqcol::AutotuneReport& tune) {
+    for (auto &t : tune.timings) {
+        printf("  [autotune] %-24s %8d iter em %.4fs -> %.0f iter/s\n", t.name().c_str(), t.iterations, t.seconds, t.rate);
+    }
+    printf("Autotune: %s (%.3fs)\n", tune.choice().c_str(), tune.total_seconds);
+}
+
+// Calibra os kernels (opcional) e resolve com a combinação escolhida
+template <class Graph>
+static int tune_and_solve(const Graph& inst, const Arguments& args, tabueqcol::SolverMetrics* metrics) {
+    // --- CONFIGURAÇÃO ---
+    // O relógio começa antes da calibração: ela faz parte do tempo limite (o trabalho, não:
+    // só o laço tabu da resolução lança unidades em globalStop)
+    StopCriterion globalStop(args.time_limit, args.budget, args.budget_limit);
+
+    // As métricas ao vivo só são ligadas depois da calibração: as buscas curtas dela não
+    // entram nos contadores nem no melhor k exportado
+    TabuConfig tabuConfig = make_config(args);
+
+    // Sem --threads, só a calibração experimenta todos os núcleos; a execução manual fica
+    // com uma thread, como a busca original
+    int max_threads = args.threads > 0 ? args.threads : (args.autotune ? tabueqcol::default_thread_count() : 1);
+    // As vizinhanças amostrada e first improvement são seriais: threads extras só custariam a sincronização
+    if (tabuConfig.scan_mode != 0) max_threads = 1;
+
+    // --- MEMÓRIA: estimativa prévia e limite ---
+    if (args.mem_report) tabueqcol::report_phase("leitura");
+    constexpr bool explicit_graph = std::is_same_v<Graph, tabueqcol::Instance>;
+    long long n = inst.n, k0 = inst.max_degree + 1, m = 0;
+    if constexpr (explicit_graph) m = inst.m;
+
+    tabueqcol::AutotuneLimits limits;
+    bool may_bitset = explicit_graph && args.autotune && tabueqcol::BitsetGraph::bytes_for(inst.n) <= limits.bitset_bytes;
+    bool may_counters = args.autotune ? (size_t)(n * k0 * sizeof(int)) <= limits.counter_bytes : tabuConfig.dense_counters != 0;
+    // O grafo já está carregado: usa os bytes medidos no lugar da fórmula
+    tabueqcol::MemoryReport graph_mem;
+    inst.memory_report(graph_mem);
+    auto preflight = [&](bool counters, bool bitset) {
+        auto E = tabueqcol::estimate_memory(n, m, k0, explicit_graph, counters, tabuConfig.scan_mode == 1, bitset);
+        E.instance = graph_mem.total();
+        return E;
+    };
+    auto estimate = preflight(may_counters, may_bitset);
+    if (args.mem_report) estimate.print(stdout);
+
+    long long mem_limit = args.mem_limit_mb << 20;
+    if (mem_limit > 0 && estimate.total() > mem_limit) {
+        if (args.mem_policy == 1 && (may_bitset || may_counters)) {
+            // Rebaixa: sem matriz de bits e sem contadores densos (os kernels esparsos bastam)
+            limits.bitset_bytes = 0;
+            limits.counter_bytes = 0;
+            tabuConfig.dense_counters = 0;
+            estimate = preflight(false, false);
+            printf("Memoria acima do limite (%lld MB): rebaixado para kernels esparsos\n", args.mem_limit_mb);
+            if (args.mem_report) estimate.print(stdout);
+        }
+        if (estimate.total() > mem_limit) {
+            std::cerr << "ERRO: memoria estimada (" << (estimate.total() >> 20) << " MB) acima do limite de "
+                      << args.mem_limit_mb << " MB\n";
+            return 3;
         }
-        double total_time = globalStop.get_elapsed();
+    }
 
-        // --- GRAVAÇÃO CSV ---
-        // Abre em modo APPEND para não sobrescrever testes anteriores
-        std::ofstream outfile(args.output_file, std::ios::app);
-        
-        if (outfile.is_open()) {
-            // Se arquivo for novo/vazio, escreve cabeçalho COMPLETO
-            // Incluindo os parâmetros do teste para análise posterior
-            outfile.seekp(0, std::ios::end);
-            if (outfile.tellp() == 0) {
-                outfile << "Instance;Seed;"
-                        << "Alpha;Beta;P_Limit;P_Str;Asp;" // Parâmetros do Teste
-                        << "SI;SF;Dev(%);Time(s);TotalIter\n"; // Resultados
+    // --- COMPONENTES CONEXAS ---
+    // Portfólio, sondagem e pool de classes trabalham sobre o grafo inteiro: não se combinam
+    // com a descida por componente, que fica desligada
+    const bool whole_graph_mode = args.portfolio || args.probe_depth > 0 || args.class_pool > 0;
+    if constexpr (explicit_graph) {
+        if (args.components) {
+            auto split = tabueqcol::connected_components(inst);
+            if (split.count() > 1 && whole_graph_mode) {
+                printf("Componentes: %d, desligado (--portfolio, --probe_depth e --class_pool resolvem o grafo inteiro)\n",
+                       split.count());
+            } else if (split.count() > 1) {
+                printf("Componentes: %d (maior com %zu vertices)\n", split.count(), split.vertices[0].size());
+                std::string kernel = "componentes/manual";
+                if (args.autotune) {
+                    // Calibra na maior componente (a que domina o tempo), uma thread por componente
+                    tabueqcol::Instance largest = tabueqcol::induced_subgraph(inst, split.vertices[0]);
+                    limits.bitset_bytes = 0;
+                    auto tune = tabueqcol::autotune_kernels(largest, tabuConfig, args.seed, args.autotune_ms / 1000.0, 1, limits);
+                    print_autotune(tune);
+                    tune.apply(tabuConfig);
+                    kernel = "componentes/" + tune.choice();
+                }
+                tabuConfig.metrics = metrics;
+                return solve(inst, args, tabuConfig, globalStop, kernel, &split);
             }
+        }
+    } else if (args.components) {
+        // A decomposição percorre o CSR: com outra representação o grafo é resolvido inteiro
+        printf("Componentes: desligado (exige --adjacency csr); resolvendo o grafo inteiro\n");
+    }
 
-            // Escreve linha de dados
-            outfile << args.input_file << ";" 
-                    << args.seed << ";"
-                    // Parâmetros usados neste teste
-                    << tabuConfig.alpha << ";"
-                    << tabuConfig.beta << ";"
-                    << tabuConfig.perturbation_limit << ";"
-                    << tabuConfig.perturbation_strength << ";"
-                    << tabuConfig.aspiration << ";"
-                    // Resultados
-                    << initial_k << ";" 
-                    << best_k_found << ";" 
-                    << std::fixed << std::setprecision(2) << dev_percent << ";" 
-                    << std::fixed << std::setprecision(4) << total_time << ";" 
-                    << total_iterations << "\n";
-            
-            outfile.close();
-        } else {
-            std::cerr << "ERRO: Nao foi possivel escrever em " << args.output_file << "\n";
-            return 1;
+    if (!args.autotune) {
+        tabuConfig.threads = max_threads;
+        tabuConfig.metrics = metrics;
+        return solve(inst, args, tabuConfig, globalStop, "manual/x" + std::to_string(max_threads));
+    }
+
+    // --- CALIBRAÇÃO DOS KERNELS ---
+    auto tune = tabueqcol::autotune_kernels(inst, tabuConfig, args.seed, args.autotune_ms / 1000.0, max_threads, limits);
+    print_autotune(tune);
+    tune.apply(tabuConfig);
+    tabuConfig.metrics = metrics;
+    if (args.mem_report) tabueqcol::report_phase("calibracao");
+
+    if constexpr (std::is_same_v<Graph, tabueqcol::Instance>) {
+        if (tune.use_bitset) {
+            tabueqcol::BitsetGraph B(inst);
+            return solve(B, args, tabuConfig, globalStop, tune.choice());
         }
+    }
+    return solve(inst, args, tabuConfig, globalStop, tune.choice());
+}
+
+// Pico da leitura a partir do cabeçalho (n, m), antes de construir o CSR: não depende do
+// grau máximo, então dá para recusar a instância sem carregá-la
+static long long estimate_read_bytes(const std::string& path) {
+    long long n = 0, m = 0;
+    tabueqcol::read_instance_header(path, n, m);
+    return tabueqcol::estimate_memory(n, m, 1, true, false, false, false).instance_build;
+}
 
-        // Output mínimo no console só para debug visual
-        printf("=== RESULTADO FINAL ===\n");
-        printf("FIM: %s | K %d->%d | Seed %d | Tempo %.4fs | Iterações %lld\n", args.input_file.c_str(), initial_k, best_k_found, args.seed, total_time, total_iterations);
+// Modo lote: input_file lista uma instância por linha; cada uma vira um job do
+// escalonador em fatias (sem calibração: o custo seria maior que o de cada job)
+static int solve_batch(const Arguments& args, tabueqcol::SolverMetrics* metrics) {
+    std::ifstream list(args.input_file);
+    if (!list.is_open()) {
+        throw std::runtime_error("Nao foi possivel abrir a lista de instancias: " + args.input_file);
+    }
+    std::vector<std::string> paths;
+    for (std::string line; std::getline(list, line);) {
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        if (!line.empty() && line[0] != '#') paths.push_back(line);
+    }
 
-    } catch (const std::exception& e) {
-        std::cerr << "Exception: " << e.what() << "\n";
+    TabuConfig tabuConfig = make_config(args);
+    tabuConfig.metrics = metrics;
+    tabueqcol::BatchOptions opt;
+    opt.slice_iters = args.slice;
+    opt.workers = args.threads;
+    opt.max_active = args.batch_active;
+    opt.time_limit = args.time_limit;
+    opt.tiny = args.tiny;
+
+    printf("Lote: %zu instancias | fatia %lld | ativos/thread %d | lockstep n <= %d: %s\n", paths.size(),
+           opt.slice_iters, opt.max_active, tabueqcol::TINY_N, opt.tiny ? "sim" : "nao");
+
+    // --mem_limit_mb vale por instância: a leitura é recusada pelo cabeçalho e a busca pela
+    // estimativa com o grau máximo (sem rebaixamento: a configuração é a mesma para todos os jobs)
+    const long long mem_limit = args.mem_limit_mb << 20;
+    auto load = [&](int i) {
+        if (mem_limit > 0 && estimate_read_bytes(paths[i]) > mem_limit) {
+            throw std::runtime_error("memoria estimada da leitura acima de " + std::to_string(args.mem_limit_mb) + " MB");
+        }
+        tabueqcol::Instance I = tabueqcol::read_instance(paths[i]);
+        auto E = tabueqcol::estimate_memory(I.n, I.m, I.max_degree + 1, true, tabuConfig.dense_counters != 0,
+                                            tabuConfig.scan_mode == 1, false);
+        if (mem_limit > 0 && E.total() > mem_limit) {
+            throw std::runtime_error("memoria estimada (" + std::to_string(E.total() >> 20) + " MB) acima de " +
+                                     std::to_string(args.mem_limit_mb) + " MB");
+        }
+        return I;
+    };
+
+    StopCriterion wall(1e300);
+    std::mutex out_mu;
+    std::vector<double> latencies;
+    int failures = 0;
+
+    tabueqcol::run_batch<tabueqcol::Instance>((int)paths.size(),
+        load, tabuConfig, args.seed, args.max_iter, opt,
+        [&](tabueqcol::BatchJobReport<tabueqcol::Instance>& r) {
+            std::lock_guard<std::mutex> lk(out_mu);
+            latencies.push_back(r.latency_seconds);
+            if (!r.error.empty()) {
+                std::cerr << "ERRO: " << paths[r.index] << ": " << r.error << "\n";
+                failures++;
+                return;
+            }
+            const auto& D = r.descent;
+            double dev = D.initial_k > 0 ? 100.0 * (D.initial_k - D.best_k) / D.initial_k : 0.0;
+            if (!append_csv_line(args.output_file, paths[r.index], args.seed, tabuConfig,
+                                 D.initial_k, D.best_k, dev, r.latency_seconds, D.total_iterations,
+                                 r.tiny ? "lote/lockstep" : "lote/fatias")) {
+                failures++;
+            }
+        });
+
+    double total = wall.get_elapsed();
+    std::sort(latencies.begin(), latencies.end());
+    auto pct = [&](double p) {
+        if (latencies.empty()) return 0.0;
+        size_t i = (size_t)std::min<double>(latencies.size() - 1, p * latencies.size());
+        return latencies[i];
+    };
+    printf("=== RESULTADO FINAL (LOTE) ===\n");
+    printf("Jobs %zu | Falhas %d | Tempo %.4fs | %.1f jobs/s | Latencia p50 %.4fs p99 %.4fs max %.4fs\n",
+           paths.size(), failures, total, total > 0 ? paths.size() / total : 0.0,
+           pct(0.50), pct(0.99), latencies.empty() ? 0.0 : latencies.back());
+    return failures == 0 ? 0 : 1;
+}
+
+// Modo online: a instância é reproduzida como um fluxo (vértice v chega com as arestas
+// para os vértices anteriores); mede a latência por chegada e espera o refinamento fechar
+static int solve_online(const Arguments& args, tabueqcol::SolverMetrics* metrics) {
+    const tabueqcol::Instance inst = tabueqcol::read_instance(args.input_file);
+    StopCriterion globalStop(args.time_limit);
+
+    tabueqcol::OnlineOptions opt;
+    opt.k = std::max(1, args.online_k);
+    opt.seed = args.seed;
+    opt.config.alpha = args.alpha;
+    opt.config.beta = (int)args.beta;
+    opt.config.aspiration = args.aspiration;
+    // A varredura completa seguraria o mutex por O(|C(s)| n): só muda se pedida
+    if (args.scan_mode != 0) opt.config.scan_mode = args.scan_mode;
+    opt.config.metrics = metrics;
+
+    std::vector<double> latency(inst.n);
+    std::vector<int> nbrs;
+    tabueqcol::OnlineColoring online(opt);
+    for (int v = 0; v < inst.n; ++v) {
+        nbrs.clear();
+        for (int u : inst.adj[v]) {
+            if (u < v) nbrs.push_back(u);
+        }
+        auto t0 = std::chrono::high_resolution_clock::now();
+        online.add_vertex(nbrs);
+        latency[v] = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - t0).count();
+    }
+    double stream_time = globalStop.get_elapsed();
+    bool proper = online.wait_proper(globalStop);
+    // Fluxo encerrado: o tempo que sobra devolve as cores abertas pelo refinamento
+    if (proper) online.reduce_colors(globalStop, args.max_iter);
+
+    auto snap = online.snapshot();
+    auto st = online.statistics();
+    std::sort(latency.begin(), latency.end());
+    auto pct = [&](double p) {
+        if (latency.empty()) return 0.0;
+        return 1e6 * latency[(size_t)std::min<double>(latency.size() - 1, p * latency.size())];
+    };
+    printf("Online: %d chegadas em %.4fs | diretas %lld | reparadas %lld | trocas %lld (%lld movimentos) | com conflito %lld | cores abertas %lld, devolvidas %lld\n",
+           inst.n, stream_time, st.direct, st.repaired, st.exchanged, st.repair_moves, st.conflicted, st.colors_added,
+           st.colors_removed);
+    printf("Latencia por chegada: p50 %.1fus p99 %.1fus max %.1fus\n", pct(0.50), pct(0.99),
+           latency.empty() ? 0.0 : 1e6 * latency.back());
+
+    double total_time = globalStop.get_elapsed();
+    double dev = opt.k > 0 ? 100.0 * (opt.k - snap.k) / opt.k : 0.0;
+    if (!append_csv_line(args.output_file, args.input_file, args.seed, opt.config,
+                         opt.k, snap.k, dev, total_time, st.refine_iterations, "online")) {
         return 1;
     }
-    return 0;
+    if (!args.solution_file.empty()) {
+        auto rep = tabueqcol::verify_coloring(inst, snap.color, snap.k);
+        if (!rep.ok()) {
+            std::cerr << "ERRO: solucao final nao passou na verificacao:\n";
+            for (auto &viol : rep.violations) std::cerr << "  " << viol.describe() << "\n";
+            return 1;
+        }
+        tabueqcol::write_coloring(args.solution_file, snap.color, snap.k);
+    }
+
+    printf("=== RESULTADO FINAL (ONLINE) ===\n");
+    printf("FIM: %s | K %d->%d | Conflitos %lld | Seed %d | Tempo %.4fs | Iterações %lld\n", args.input_file.c_str(),
+           opt.k, snap.k, snap.obj, args.seed, total_time, st.refine_iterations);
+    return proper ? 0 : 1;
 }
 
+// Modo semi-externo: a entrada é um .ecsr (ver external.hpp); só o estado O(n) fica em RAM
+// e cada passada relê a adjacência do disco. max_iter limita o número de passadas.
+static int solve_external(const Arguments& args) {
+    StopCriterion globalStop(args.time_limit);
+
+    tabueqcol::ExternalOptions opt;
+    opt.seed = args.seed;
+    opt.chunk_bytes = (size_t)std::max(1, args.external_chunk_mb) << 20;
+    opt.max_passes = args.max_iter;
+    opt.verbose = true;
+
+    tabueqcol::SemiExternalColoring S(args.input_file, opt);
+    const auto& H = S.reader().header();
+    printf("Semi-externo: n %lld | m %lld | grau maximo %lld | leitura em blocos de %d MB\n",
+           (long long)H.n, (long long)H.m, (long long)H.max_degree, args.external_chunk_mb);
+
+    auto R = S.run(globalStop);
+    if (args.mem_report) {
+        tabueqcol::report_phase("busca");
+        R.memory.print(stdout);
+    }
+
+    double total_time = globalStop.get_elapsed();
+    double dev = R.initial_k > 0 ? 100.0 * (R.initial_k - R.best_k) / R.initial_k : 0.0;
+    TabuConfig tabuConfig = make_config(args);
+    if (!append_csv_line(args.output_file, args.input_file, args.seed, tabuConfig,
+                         R.initial_k, R.best_k, dev, total_time, R.passes, "semi-externo")) {
+        return 1;
+    }
+    if (!args.solution_file.empty()) {
+        // Verificação independente numa passada extra pelo arquivo
+        auto check = tabueqcol::check_external(S.reader(), R.best_color, R.best_k);
+        if (!check.ok()) {
+            std::cerr << "ERRO: solucao final nao passou na verificacao: " << check.conflicting_edges
+                      << " arestas em conflito, classes de " << check.min_class << " a " << check.max_class << "\n";
+            return 1;
+        }
+        tabueqcol::write_coloring(args.solution_file, R.best_color, R.best_k);
+    }
 
-static void die(const string &msg) {
-    cerr << msg << "\n";
-    exit(1);
+    printf("=== RESULTADO FINAL (SEMI-EXTERNO) ===\n");
+    printf("FIM: %s | K %d->%d | Seed %d | Tempo %.4fs | Passadas %lld | Movimentos %lld | Lidos %.1f MB\n",
+           args.input_file.c_str(), R.initial_k, R.best_k, args.seed, total_time, R.passes, R.moves,
+           tabueqcol::to_mb(R.bytes_read));
+    return 0;
 }
 
+int main(int argc, char** argv) {
+    try {
+        Arguments args = parse_arguments(argc, argv);
 
+        // Métricas ao vivo: o exportador grava em segundo plano até o fim do processo
+        tabueqcol::SolverMetrics metrics;
+        std::unique_ptr<tabueqcol::MetricsExporter> exporter;
+        if (!args.metrics_file.empty()) {
+            exporter.reset(new tabueqcol::MetricsExporter(metrics, args.metrics_file, args.metrics_interval_ms));
+        }
+        tabueqcol::SolverMetrics* live = exporter ? &metrics : nullptr;
 
-tabueqcol::Instance read_instance(const string &path){
-    ifstream in(path);
-    if(!in) die("Cannot open instance file: " + path);
-    
-    tabueqcol::Instance I;
-    int kpairs;
-    
-    if(!(in >> I.n >> kpairs)) die("Bad instance header");
-    
-    I.edges.reserve(kpairs);
-    
-    for(int t=0; t<kpairs; ++t){
-        int a, b; 
-        in >> a >> b;
-        // Assume input 1-based -> converte para 0-based aqui
-        I.edges.emplace_back(a-1, b-1);
-    }
+        if (args.batch) return solve_batch(args, live);
+        if (args.online) return solve_online(args, live);
+        if (tabueqcol::is_external_file(args.input_file)) return solve_external(args);
 
-    I.build_adj(); 
+        // --- LEITURA DA INSTÂNCIA ---
+        // --external_out: só converte para o formato em disco do modo semi-externo
+        auto solve_or_convert = [&](const auto& g) {
+            if (args.external_out.empty()) return tune_and_solve(g, args, live);
+            tabueqcol::write_external_graph(g, args.external_out);
+            printf("Grafo gravado em %s (n %d)\n", args.external_out.c_str(), g.n);
+            return 0;
+        };
+        // Grafos implícitos (kneser:..., geometric:..., interval:...) não materializam a adjacência
+        if (args.input_file.rfind("kneser:", 0) == 0) {
+            return solve_or_convert(tabueqcol::KneserGraph::from_spec(args.input_file));
+        }
+        if (args.input_file.rfind("geometric:", 0) == 0) {
+            return solve_or_convert(tabueqcol::GeometricGraph::from_spec(args.input_file));
+        }
+        if (args.input_file.rfind("interval:", 0) == 0) {
+            return solve_or_convert(tabueqcol::IntervalGraph::from_spec(args.input_file));
+        }
+
+        // Pré-checagem pelo cabeçalho: o pico da construção do CSR é o primeiro a estourar
+        const long long read_bytes = estimate_read_bytes(args.input_file);
+        if (args.mem_report) printf("Memoria estimada da leitura: %.1f MB\n", tabueqcol::to_mb(read_bytes));
+        if (args.mem_limit_mb > 0 && read_bytes > (args.mem_limit_mb << 20)) {
+            std::cerr << "ERRO: memoria estimada da leitura (" << (read_bytes >> 20) << " MB) acima do limite de "
+                      << args.mem_limit_mb << " MB\n";
+            return 3;
+        }
+        // Só a lista de arestas: with_storage monta a representação (compressed sem o CSR)
+        tabueqcol::Instance inst = tabueqcol::read_instance(args.input_file, false);
+        if (!args.external_out.empty()) {
+            inst.build_adj();
+            return solve_or_convert(inst);
+        }
+        // O complemento e a matriz de bits podem ser muito maiores que o CSR (grafos esparsos):
+        // decide antes de montá-los
+        int adjacency = args.adjacency;
+        if (adjacency == tabueqcol::STORAGE_COMPLEMENT || adjacency == tabueqcol::STORAGE_BITSET) {
+            const bool complement = adjacency == tabueqcol::STORAGE_COMPLEMENT;
+            const char* label = complement ? "complemento" : "matriz de bits";
+            inst.build_adj(); // m final (sem arestas repetidas); with_storage montaria o CSR de qualquer forma
+            long long dense_bytes = complement ? tabueqcol::ComplementGraph::bytes_for(inst.n, inst.m)
+                                               : (long long)tabueqcol::BitsetGraph::bytes_for(inst.n);
+            long long csr_bytes = tabueqcol::CompressedGraph::csr_bytes(inst.n, inst.m);
+            long long mem_limit = args.mem_limit_mb << 20;
+            if (mem_limit > 0 && dense_bytes > mem_limit) {
+                if (args.mem_policy != 1) {
+                    std::cerr << "ERRO: " << label << " (" << (dense_bytes >> 20) << " MB) acima do limite de "
+                              << args.mem_limit_mb << " MB\n";
+                    return 3;
+                }
+                printf("Adjacencia: %s (%.1f MB) acima do limite (%lld MB): rebaixado para csr\n",
+                       label, tabueqcol::to_mb(dense_bytes), args.mem_limit_mb);
+                adjacency = tabueqcol::STORAGE_CSR;
+            } else if (dense_bytes > csr_bytes) {
+                printf("Aviso: %s (%.3f MB) maior que o CSR (%.3f MB): o grafo nao e denso\n",
+                       label, tabueqcol::to_mb(dense_bytes), tabueqcol::to_mb(csr_bytes));
+            }
+        }
+        // Representação escolhida uma vez: cada uma instancia a busca inteira (storage.hpp)
+        return tabueqcol::with_storage(inst, adjacency, [&](const auto& G) {
+            if constexpr (!std::is_same_v<std::decay_t<decltype(G)>, tabueqcol::Instance>) {
+                tabueqcol::MemoryReport R;
+                G.memory_report(R);
+                printf("Adjacencia %s: %.3f MB (CSR %.3f MB)\n", tabueqcol::storage_name(adjacency),
+                       tabueqcol::to_mb(R.total()), tabueqcol::to_mb(tabueqcol::CompressedGraph::csr_bytes(inst.n, inst.m)));
+            }
+            return tune_and_solve(G, args, live);
+        });
 
-    return I;
+    } catch (const std::exception& e) {
+        std::cerr << "Exception: " << e.what() << "\n";
+        return 1;
+    }
+    return 0;
 }
 
 
@@ -0,0 +1,155 @@
+// memory.hpp
+// C++17 header-only: memória por estrutura, RSS/pico por fase e estimativa prévia
+//
+// Usage example (sketch):
+//   MemoryEstimate E = estimate_memory(n, m, k0, true, dense, sampled, bitset); // antes da busca
+//   if (limit > 0 && E.total() > limit) ...                        // recusar ou rebaixar
+//   MemoryReport R; inst.memory_report(R); S.memory_report(R, "best.");
+//   R.print(stdout);                                               // bytes por estrutura
+//   report_phase("busca");                                         // RSS atual e pico
+//   PeakMemoryReport P; config.memory_peak = &P;                   // retrato da busca mais cara
+//
+
+#pragma once
+#include <cstdio>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include "portable.hpp"
+
+namespace tabueqcol {
+
+// Memória residente atual do processo (bytes); 0 se /proc não estiver disponível
+inline long long current_rss_bytes() {
+    std::ifstream f("/proc/self/statm");
+    long long pages_total = 0, pages_resident = 0;
+    if (!(f >> pages_total >> pages_resident)) return 0;
+    return pages_resident * page_size_bytes();
+}
+
+// Pico de memória residente do processo (VmHWM, bytes); 0 se indisponível
+inline long long peak_rss_bytes() {
+    std::ifstream f("/proc/self/status");
+    std::string key;
+    while (f >> key) {
+        if (key == "VmHWM:") {
+            long long kb = 0;
+            f >> kb;
+            return kb * 1024;
+        }
+        std::getline(f, key);
+    }
+    return 0;
+}
+
+// Bytes alocados por um vetor (capacidade, não tamanho)
+template <class T>
+long long vector_bytes(const std::vector<T>& v) {
+    return (long long)v.capacity() * (long long)sizeof(T);
+}
+
+template <class T>
+long long vector_bytes(const std::vector<std::vector<T>>& v) {
+    long long b = (long long)v.capacity() * (long long)sizeof(std::vector<T>);
+    for (const auto& row : v) b += vector_bytes(row);
+    return b;
+}
+
+inline double to_mb(long long bytes) { return bytes / (1024.0 * 1024.0); }
+
+struct MemoryItem {
+    std::string name;
+    long long bytes = 0;
+};
+
+// Bytes efetivamente mantidos por cada estrutura (preenchido pelos memory_report)
+struct MemoryReport {
+    std::vector<MemoryItem> items;
+
+    void add(const std::string& name, long long bytes) { items.push_back({name, bytes}); }
+
+    long long total() const {
+        long long t = 0;
+        for (const auto& it : items) t += it.bytes;
+        return t;
+    }
+
+    void print(FILE* out) const {
+        for (const auto& it : items) {
+            if (it.bytes > 0) fprintf(out, "  [mem] %-28s %12.3f MB\n", it.name.c_str(), to_mb(it.bytes));
+        }
+        fprintf(out, "  [mem] %-28s %12.3f MB\n", "total", to_mb(total()));
+    }
+};
+
+// Retrato por estrutura da busca de maior consumo: cada busca oferece o seu antes de liberar
+// matriz tabu, contadores e listas (depois dela só sobram o grafo e as soluções). Buscas
+// simultâneas (componentes, portfólio) oferecem da própria thread.
+struct PeakMemoryReport {
+    void offer(MemoryReport R) {
+        std::lock_guard<std::mutex> lk(mu);
+        if (R.total() > peak.total()) peak = std::move(R);
+    }
+
+    MemoryReport snapshot() {
+        std::lock_guard<std::mutex> lk(mu);
+        return peak;
+    }
+
+private:
+    std::mutex mu;
+    MemoryReport peak;
+};
+
+// Estimativa feita antes da busca a partir de (n, m, k inicial) e da configuração
+struct MemoryEstimate {
+    long long instance_build = 0;  // pico da construção do CSR (lista bruta + linhas brutas, ou linhas + final)
+    long long instance = 0;        // grafo: CSR final (ou as estruturas de um grafo implícito)
+    long long solutions = 0;       // cópias do SolutionManager (atual, melhor, próxima)
+    long long tabu = 0;            // matriz tabu n x k (só a busca em andamento)
+    long long counters = 0;        // contadores densos n x k
+    long long class_members = 0;   // listas por classe (modo amostrado)
+    long long bitset = 0;          // matriz de adjacência em bits
+
+    // Pico esperado: a construção do CSR termina antes de a busca alocar
+    long long total() const {
+        long long search = instance + solutions + tabu + counters + class_members + bitset;
+        return std::max(instance_build, search);
+    }
+
+    void print(FILE* out) const {
+        fprintf(out, "Memoria estimada: %.1f MB (grafo %.1f | solucoes %.1f | tabu %.1f | contadores %.1f | bitset %.1f | pico da leitura %.1f)\n",
+                to_mb(total()), to_mb(instance), to_mb(solutions), to_mb(tabu), to_mb(counters),
+                to_mb(bitset), to_mb(instance_build));
+    }
+};
+
+// n, m: tamanho da instância; k: k inicial da descida (Delta + 1); explicit_graph = false para
+// grafos implícitos (sem CSR). Os flags seguem os campos homônimos de TabuConfig.
+inline MemoryEstimate estimate_memory(long long n, long long m, long long k, bool explicit_graph,
+                                      bool dense_counters, bool sampled_scan, bool bitset) {
+    MemoryEstimate E;
+    const long long I = sizeof(int), L = sizeof(long long), V = sizeof(std::vector<int>);
+    if (explicit_graph) {
+        E.instance = (n + 1) * L + 2 * m * I + n * I;
+        // A lista bruta sai antes da compactação (Instance::build_rows)
+        E.instance_build = std::max(m * 2 * I + (n + 1) * L * 2 + 2 * m * I, (n + 1) * L + 2 * m * I + E.instance);
+    }
+    // color, conflicts, conflictingVertices, conflictingIndex + classSize; atual + melhor + próxima
+    long long per_solution = 4 * n * I + k * I;
+    E.solutions = 3 * per_solution;
+    E.tabu = n * (k * I + V);
+    if (dense_counters) E.counters = n * k * I;
+    if (sampled_scan) E.class_members = 2 * n * I + k * V;
+    if (bitset) E.bitset = n * ((n + 63) / 64) * 8;
+    return E;
+}
+
+// Uma linha por fase: RSS atual e pico do processo até aqui
+inline void report_phase(const char* phase) {
+    printf("  [mem] fase %-12s RSS %.1f MB | pico %.1f MB\n", phase, to_mb(current_rss_bytes()), to_mb(peak_rss_bytes()));
+}
+
+} // namespace tabueqcol
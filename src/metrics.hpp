@@ -0,0 +1,170 @@
+// metrics.hpp
+// C++17 header-only: contadores ao vivo do solver no formato texto do Prometheus
+//
+// Usage example (sketch):
+//   SolverMetrics M;
+//   config.metrics = &M;                                // o laço do tabu publica em M
+//   MetricsExporter exp(M, "/var/lib/node_exporter/tabu_ecp.prom", 1000);
+//   ... busca ...                                       // o exportador grava a cada 1s
+//
+// O laço publica só a cada config.time_check_every iterações, com stores relaxados em
+// atômicos (sem trava); o exportador lê um snapshot numa thread própria e grava o
+// arquivo de forma atômica (arquivo temporário + rename), como espera o coletor
+// "textfile" do node_exporter.
+
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <fstream>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <algorithm>
+#include "memory.hpp"
+
+namespace tabueqcol {
+
+// Valores lidos de uma vez (cada campo é consistente; o conjunto é aproximado)
+struct MetricsSnapshot {
+    long long k = 0;
+    long long obj = 0;
+    long long best_obj = 0;
+    long long conflicting = 0;
+    long long iterations = 0;
+    long long perturbations = 0;
+    long long best_k = 0;
+    long long jobs_queued = 0;
+    long long jobs_active = 0;
+    long long jobs_done = 0;
+};
+
+struct SolverMetrics {
+    // Busca atual (gauges)
+    std::atomic<long long> k{0};
+    std::atomic<long long> obj{0};
+    std::atomic<long long> best_obj{0};
+    std::atomic<long long> conflicting{0};
+    std::atomic<long long> best_k{0};           // menor k resolvido na descida
+    // Contadores acumulados
+    std::atomic<long long> iterations{0};
+    std::atomic<long long> perturbations{0};
+    // Modo lote
+    std::atomic<long long> jobs_queued{0};
+    std::atomic<long long> jobs_active{0};
+    std::atomic<long long> jobs_done{0};
+
+    MetricsSnapshot snapshot() const {
+        MetricsSnapshot s;
+        s.k = k.load(std::memory_order_relaxed);
+        s.obj = obj.load(std::memory_order_relaxed);
+        s.best_obj = best_obj.load(std::memory_order_relaxed);
+        s.conflicting = conflicting.load(std::memory_order_relaxed);
+        s.best_k = best_k.load(std::memory_order_relaxed);
+        s.iterations = iterations.load(std::memory_order_relaxed);
+        s.perturbations = perturbations.load(std::memory_order_relaxed);
+        s.jobs_queued = jobs_queued.load(std::memory_order_relaxed);
+        s.jobs_active = jobs_active.load(std::memory_order_relaxed);
+        s.jobs_done = jobs_done.load(std::memory_order_relaxed);
+        return s;
+    }
+};
+
+// Formato texto de exposição do Prometheus (versão 0.0.4)
+inline std::string render_prometheus(const MetricsSnapshot& s, double iterations_per_second,
+                                     long long rss_bytes, long long peak_rss, double uptime_seconds) {
+    std::ostringstream out;
+    auto metric = [&](const char* name, const char* type, const char* help, auto value) {
+        out << "# HELP " << name << " " << help << "\n";
+        out << "# TYPE " << name << " " << type << "\n";
+        out << name << " " << value << "\n";
+    };
+    metric("tabu_ecp_k", "gauge", "Numero de cores da busca atual", s.k);
+    metric("tabu_ecp_best_k", "gauge", "Menor k resolvido ate agora", s.best_k);
+    metric("tabu_ecp_obj", "gauge", "Arestas conflitantes na solucao atual", s.obj);
+    metric("tabu_ecp_best_obj", "gauge", "Menor numero de conflitos da busca atual", s.best_obj);
+    metric("tabu_ecp_conflicting_vertices", "gauge", "Vertices em conflito |C(s)|", s.conflicting);
+    metric("tabu_ecp_iterations_total", "counter", "Iteracoes de tabu executadas", s.iterations);
+    metric("tabu_ecp_iterations_per_second", "gauge", "Vazao desde o snapshot anterior", iterations_per_second);
+    metric("tabu_ecp_perturbations_total", "counter", "Perturbacoes aplicadas", s.perturbations);
+    metric("tabu_ecp_resident_memory_bytes", "gauge", "Memoria residente do processo", rss_bytes);
+    metric("tabu_ecp_peak_resident_memory_bytes", "gauge", "Pico de memoria residente do processo", peak_rss);
+    metric("tabu_ecp_jobs_queued", "gauge", "Jobs do lote aguardando admissao", s.jobs_queued);
+    metric("tabu_ecp_jobs_active", "gauge", "Jobs do lote em execucao", s.jobs_active);
+    metric("tabu_ecp_jobs_done_total", "counter", "Jobs do lote concluidos", s.jobs_done);
+    metric("tabu_ecp_uptime_seconds", "gauge", "Tempo desde o inicio da exportacao", uptime_seconds);
+    return out.str();
+}
+
+// Thread que grava o snapshot periodicamente (e uma última vez ao ser destruída)
+class MetricsExporter {
+public:
+    MetricsExporter(const SolverMetrics& m, std::string path, int interval_ms = 1000)
+        : metrics(m), path(std::move(path)), interval(std::max(10, interval_ms)),
+          start(std::chrono::steady_clock::now()), last_time(start) {
+        worker = std::thread([this] { loop(); });
+    }
+
+    ~MetricsExporter() {
+        {
+            std::lock_guard<std::mutex> lk(mu);
+            stopping = true;
+        }
+        cv.notify_all();
+        worker.join();
+        write_now();
+    }
+
+    MetricsExporter(const MetricsExporter&) = delete;
+    MetricsExporter& operator=(const MetricsExporter&) = delete;
+
+    // Grava um snapshot agora; devolve false se o arquivo não pôde ser escrito
+    bool write_now() {
+        std::lock_guard<std::mutex> lk(write_mu);
+        auto now = std::chrono::steady_clock::now();
+        MetricsSnapshot s = metrics.snapshot();
+
+        double dt = std::chrono::duration<double>(now - last_time).count();
+        double rate = dt > 0 ? (s.iterations - last_iterations) / dt : 0.0;
+        last_time = now;
+        last_iterations = s.iterations;
+
+        double uptime = std::chrono::duration<double>(now - start).count();
+        std::string text = render_prometheus(s, rate, current_rss_bytes(), peak_rss_bytes(), uptime);
+
+        std::string tmp = path + ".tmp";
+        {
+            std::ofstream f(tmp, std::ios::trunc);
+            if (!f.is_open()) return false;
+            f << text;
+            if (!f.good()) return false;
+        }
+        return std::rename(tmp.c_str(), path.c_str()) == 0;
+    }
+
+private:
+    void loop() {
+        std::unique_lock<std::mutex> lk(mu);
+        while (!stopping) {
+            if (cv.wait_for(lk, std::chrono::milliseconds(interval), [this] { return stopping; })) break;
+            lk.unlock();
+            write_now();
+            lk.lock();
+        }
+    }
+
+    const SolverMetrics& metrics;
+    std::string path;
+    int interval;
+    std::chrono::steady_clock::time_point start, last_time;
+    long long last_iterations = 0;
+
+    std::mutex mu, write_mu;
+    std::condition_variable cv;
+    bool stopping = false;
+    std::thread worker;
+};
+
+} // namespace tabueqcol
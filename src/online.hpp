@@ -0,0 +1,524 @@
+// online.hpp
+// C++17 header-only: coloração equitativa mantida online enquanto vértices chegam
+//
+// Usage example (sketch):
+//   OnlineOptions opt;                       // k inicial, reparo limitado, refinamento ligado
+//   OnlineColoring online(opt);
+//   auto a = online.add_vertex({3, 17, 42}); // vizinhos já existentes (ids 0-based)
+//   a.vertex / a.color / a.conflicts         // onde o vértice ficou e o que sobrou de conflito
+//   auto snap = online.snapshot();           // cópia consistente: color, k, obj
+//
+// Cada chegada custa O(grau + k) no caso comum e nunca dispara uma resolução completa:
+//   1. o vértice entra numa classe mínima (tamanho floor(n/k)) sem vizinhos dele;
+//   2. se não houver, uma cadeia curta de transferências abre espaço: o vértice entra numa
+//      classe livre X0 (grande), um vértice de X0 passa para X1 (sem vizinhos lá), ... até
+//      uma classe mínima; cada passo é um apply_move, a coloração segue própria e equitativa;
+//   3. sem cadeia, uma troca (exchange): numa classe mínima com um só vizinho u do vértice
+//      novo, u troca de classe com um w de outra classe Y (tamanhos inalterados, sem
+//      conflito novo) e o vértice entra no lugar de u;
+//   4. se o reparo estourar o orçamento, o vértice entra na classe mínima com menos
+//      vizinhos e os conflitos ficam para o refinamento (stats.conflicted conta esses).
+// A garantia é, portanto, "sempre equitativa, própria depois do refinamento": a coloração
+// só é própria a cada chegada quando 1-3 dão conta.
+// O refinamento é a mesma busca tabu (begin_search/step_search, em modo persistente) numa
+// thread de fundo, em fatias curtas sob o mesmo mutex; chegadas têm prioridade entre
+// fatias. Se os conflitos resistem por grow_after iterações, a thread abre mais uma cor
+// (append_color) e rebalanceia; k para em Delta + 1, onde sempre existe coloração
+// equitativa própria (Hajnal-Szemerédi). As cores abertas às pressas voltam com
+// reduce_colors(), com o fluxo parado: descida em k a partir da coloração atual, até opt.k.
+
+#pragma once
+#include <vector>
+#include <random>
+#include <mutex>
+#include <thread>
+#include <atomic>
+#include <condition_variable>
+#include <stdexcept>
+#include <string>
+#include <algorithm>
+#include <climits>
+#include "tabu_search.hpp"
+
+namespace tabueqcol {
+
+// ------------------ Grafo que cresce ------------------
+// Listas de adjacência crescentes: o vértice novo tem sempre o maior id, então basta
+// acrescentá-lo ao fim da lista de cada vizinho. Segue o conceito de grafo de tabu_search.hpp.
+struct DynamicGraph {
+    int n = 0;
+    long long m = 0;
+    int max_degree = 0;
+    std::vector<std::vector<int>> adj;
+
+    int degree(int v) const { return (int)adj[v].size(); }
+
+    template <class F>
+    void for_each_neighbour(int v, F&& f) const {
+        for (int u : adj[v]) {
+            if (!visit_neighbour(f, u)) return;
+        }
+    }
+
+    bool adjacent(int u, int v) const {
+        const auto& r = adj[u].size() <= adj[v].size() ? adj[u] : adj[v];
+        int w = (&r == &adj[u]) ? v : u;
+        return std::binary_search(r.begin(), r.end(), w);
+    }
+
+    // Ordena, remove repetidos e valida os vizinhos de um vértice novo (ids existentes)
+    void normalize_neighbours(std::vector<int>& nbrs) const {
+        std::sort(nbrs.begin(), nbrs.end());
+        nbrs.erase(std::unique(nbrs.begin(), nbrs.end()), nbrs.end());
+        if (!nbrs.empty() && (nbrs.front() < 0 || nbrs.back() >= n)) {
+            throw std::runtime_error("Online vertex has neighbour out of range: " +
+                                     std::to_string(nbrs.front() < 0 ? nbrs.front() : nbrs.back()));
+        }
+    }
+
+    // Acrescenta o vértice n ligado a 'nbrs'. Valida tudo antes de alterar o grafo.
+    int add_vertex(std::vector<int> nbrs) {
+        normalize_neighbours(nbrs);
+        int v = n++;
+        for (int u : nbrs) {
+            adj[u].push_back(v);
+            max_degree = std::max(max_degree, (int)adj[u].size());
+        }
+        max_degree = std::max(max_degree, (int)nbrs.size());
+        m += (long long)nbrs.size();
+        adj.push_back(std::move(nbrs));
+        return v;
+    }
+
+    void memory_report(MemoryReport& R) const {
+        R.add("dynamic.adj", vector_bytes(adj));
+    }
+};
+
+struct OnlineOptions {
+    int k = 1;                   // cores iniciais (crescem quando o refinamento não fecha)
+    int repair_depth = 3;        // transferências por cadeia de reparo
+    int repair_budget = 256;     // vértices examinados por chegada no reparo
+    // 1 = thread de refinamento em fundo. Com um só núcleo ela disputaria a CPU (e o mutex)
+    // com as chegadas: refine_step/wait_proper refinam na thread de quem chama
+    int refine = default_thread_count() > 1 ? 1 : 0;
+    long long refine_slice = 8;  // iterações de tabu por posse do mutex
+    int grow_after = 2000;       // iterações sem melhora (com conflitos) antes de abrir uma cor
+    int seed = 0;
+    TabuConfig config = default_config();
+
+    // Refinamento: vizinhança amostrada com custo alvo baixo (a fatia segura o mutex) e sem
+    // perturbação (trocas aleatórias de uma fração de n não cabem numa fatia)
+    static TabuConfig default_config() {
+        TabuConfig c;
+        c.scan_mode = 1;
+        c.sample_target_us = 20.0;
+        c.perturbation_strength = 0.0;
+        c.threads = 1;
+        return c;
+    }
+};
+
+struct OnlineArrival {
+    int vertex = -1;
+    int color = -1;
+    int conflicts = 0;   // conflitos do vértice ao sair de add_vertex
+    int repair_moves = 0; // transferências da cadeia de reparo (0 = colocação direta)
+};
+
+struct OnlineStats {
+    long long arrivals = 0;
+    long long direct = 0;       // colocados numa classe mínima sem conflito
+    long long repaired = 0;     // colocados após uma cadeia de transferências
+    long long exchanged = 0;    // colocados após uma troca (exchange)
+    long long conflicted = 0;   // entraram com conflito (resolvidos pelo refinamento)
+    long long repair_moves = 0;
+    long long colors_added = 0;
+    long long colors_removed = 0; // por reduce_colors
+    long long refine_iterations = 0;
+};
+
+struct OnlineSnapshot {
+    std::vector<int> color;
+    int k = 0;
+    long long obj = 0;
+};
+
+class OnlineColoring {
+public:
+    explicit OnlineColoring(const OnlineOptions& options)
+        : opt(options), rng(options.seed) {
+        if (opt.k < 1) throw std::runtime_error("Online coloring needs k >= 1");
+        cfg = opt.config;
+        cfg.max_iter = INT_MAX;
+        S.init(&G, opt.k);
+        S.build_class_members(); // o reparo percorre as classes
+        resize_scratch();
+        if (opt.refine) worker = std::thread([this] { refine_loop(); });
+    }
+
+    ~OnlineColoring() {
+        {
+            std::lock_guard<std::mutex> lk(mu);
+            stopping = true;
+        }
+        cv.notify_all();
+        if (worker.joinable()) worker.join();
+    }
+
+    OnlineColoring(const OnlineColoring&) = delete;
+    OnlineColoring& operator=(const OnlineColoring&) = delete;
+
+    // Insere um vértice ligado a 'nbrs' (ids já existentes) e devolve onde ele ficou
+    OnlineArrival add_vertex(const std::vector<int>& nbrs) {
+        waiting.fetch_add(1, std::memory_order_relaxed);
+        std::unique_lock<std::mutex> lk(mu);
+        waiting.fetch_sub(1, std::memory_order_relaxed);
+
+        // A colocação (e a cadeia de reparo) acontece antes de o vértice entrar no grafo
+        std::vector<int> list(nbrs);
+        G.normalize_neighbours(list);
+        OnlineArrival a;
+        int c = place(list, a);
+        a.vertex = G.add_vertex(std::move(list));
+        S.append_vertex(c);
+        a.color = c;
+        a.conflicts = S.conflicts[a.vertex];
+        stats.arrivals++;
+        if (a.conflicts > 0) {
+            stats.conflicted++;
+            lk.unlock();
+            cv.notify_one();
+        }
+        return a;
+    }
+
+    // Uma fatia de refinamento na thread de quem chama (útil com refine = 0).
+    // Devolve false quando não há conflitos.
+    bool refine_step() {
+        std::lock_guard<std::mutex> lk(mu);
+        return refine_slice();
+    }
+
+    // Espera o refinamento zerar os conflitos (ou o prazo acabar); true = coloração própria
+    bool wait_proper(const StopCriterion& stop) {
+        while (!stop.is_time_up()) {
+            if (opt.refine) {
+                {
+                    std::lock_guard<std::mutex> lk(mu);
+                    if (S.obj == 0) return true;
+                }
+                std::this_thread::sleep_for(std::chrono::microseconds(200));
+            } else if (!refine_step()) {
+                return true;
+            }
+        }
+        std::lock_guard<std::mutex> lk(mu);
+        return S.obj == 0;
+    }
+
+    OnlineSnapshot snapshot() const {
+        std::lock_guard<std::mutex> lk(mu);
+        return OnlineSnapshot{S.color, S.k, S.obj};
+    }
+
+    OnlineStats statistics() const {
+        std::lock_guard<std::mutex> lk(mu);
+        return stats;
+    }
+
+    int num_vertices() const {
+        std::lock_guard<std::mutex> lk(mu);
+        return G.n;
+    }
+
+    // Grafo acumulado (só leia com o fluxo parado)
+    const DynamicGraph& graph() const { return G; }
+
+    // Descida em k a partir da coloração atual (própria), até opt.k ou o prazo: cada busca
+    // tem até max_iter iterações e segura o mutex inteira, então é para o fluxo parado.
+    // Devolve quantas cores saíram.
+    int reduce_colors(const StopCriterion& stop, int max_iter) {
+        std::lock_guard<std::mutex> lk(mu);
+        TabuConfig c = cfg;
+        c.max_iter = max_iter;
+        int removed = 0;
+        while (S.obj == 0 && S.k > opt.k && !stop.is_time_up()) {
+            BasicSolutionManager<DynamicGraph> T(G, S.k - 1);
+            T.construct_greedy_from_previous(S, opt.seed + removed);
+            if (!T.run_tabu_search(c, stop, opt.seed + removed).solved) break;
+            T.build_class_members();
+            S = std::move(T);
+            run = TabuRun();
+            started = false;
+            removed++;
+        }
+        stats.colors_removed += removed;
+        return removed;
+    }
+
+    void memory_report(MemoryReport& R) const {
+        std::lock_guard<std::mutex> lk(mu);
+        G.memory_report(R);
+        S.memory_report(R, "online.");
+    }
+
+private:
+    // ---------- Chegada ----------
+    // Escolhe a cor do vértice novo de vizinhos 'nbrs' (ainda fora do grafo). A cadeia de
+    // reparo, se houver, já é aplicada aqui; a classe devolvida é mínima ou foi esvaziada
+    // em um pela cadeia.
+    int place(const std::vector<int>& nbrs, OnlineArrival& a) {
+        const int k = S.k;
+        const int min_size = S.n / k; // tamanho das classes mínimas antes da chegada
+
+        // Vizinhos do vértice novo por cor
+        for (int u : nbrs) nb_count[S.color[u]]++;
+
+        // 1. Classe mínima sem vizinhos (início rotativo espalha as chegadas)
+        int start = std::uniform_int_distribution<int>(0, k - 1)(rng);
+        int chosen = -1;
+        for (int t = 0; t < k && chosen == -1; ++t) {
+            int c = start + t < k ? start + t : start + t - k;
+            if (S.classSize[c] == min_size && nb_count[c] == 0) chosen = c;
+        }
+        if (chosen != -1) {
+            stats.direct++;
+        } else {
+            // 2. Cadeia de transferências a partir das classes livres
+            a.repair_moves = repair_chain(min_size, chosen);
+            if (a.repair_moves > 0) {
+                stats.repaired++;
+                stats.repair_moves += a.repair_moves;
+            } else if (exchange_repair(min_size, nbrs, chosen)) {
+                // 3. Troca
+                a.repair_moves = 2;
+                stats.exchanged++;
+                stats.repair_moves += 2;
+            } else {
+                // 4. Classe mínima com menos vizinhos: conflitos ficam para o refinamento
+                for (int t = 0; t < k; ++t) {
+                    int c = start + t < k ? start + t : start + t - k;
+                    if (S.classSize[c] == min_size && (chosen == -1 || nb_count[c] < nb_count[chosen])) chosen = c;
+                }
+            }
+        }
+
+        // Por cor, não pelos vizinhos: o reparo pode ter mudado a cor de algum deles
+        std::fill(nb_count.begin(), nb_count.begin() + k, 0);
+        return chosen;
+    }
+
+    // Classe mínima c com um só vizinho u do vértice novo: u vai para Y e um w de Y vem para
+    // c. Sem conflito novo quando o único vizinho de u em Y (se houver) é w, w não é vizinho
+    // do vértice novo e w não tem vizinhos em c além de u. Orçamento: repair_budget vértices.
+    bool exchange_repair(int min_size, const std::vector<int>& nbrs, int& chosen) {
+        const int k = S.k;
+        int budget = opt.repair_budget;
+        for (int u : nbrs) {
+            const int c = S.color[u];
+            if (S.classSize[c] != min_size || nb_count[c] != 1) continue;
+            if (--budget < 0) return false;
+            G.for_each_neighbour(u, [&](int x) { u_count[S.color[x]]++; });
+            int off = std::uniform_int_distribution<int>(0, k - 1)(rng);
+            bool done = false;
+            for (int t = 0; t < k && !done && budget >= 0; ++t) {
+                int y = off + t < k ? off + t : off + t - k;
+                if (y == c || u_count[y] > 1) continue;
+                for (int w : S.classMembers[y]) {
+                    if (--budget < 0) break;
+                    if (u_count[y] == 1 && !G.adjacent(u, w)) continue;
+                    if (std::binary_search(nbrs.begin(), nbrs.end(), w)) continue;
+                    bool clear = true;
+                    G.for_each_neighbour(w, [&](int x) {
+                        if (x != u && S.color[x] == c) clear = false;
+                        return clear;
+                    });
+                    if (!clear) continue;
+                    S.apply_move(u, y);
+                    S.apply_move(w, c);
+                    chosen = c;
+                    done = true;
+                    break;
+                }
+            }
+            std::fill(u_count.begin(), u_count.begin() + k, 0);
+            if (done) return true;
+        }
+        return false;
+    }
+
+    // BFS nas classes: fontes = classes sem vizinhos do vértice novo; aresta X -> Y quando
+    // algum w de X não tem vizinhos em Y. Ao alcançar uma classe mínima, aplica as
+    // transferências do caminho e devolve quantas foram (classe do vértice novo em 'source');
+    // 0 = sem caminho no orçamento. Cada w foi testado contra a coloração original e da
+    // classe de destino só sai o w do passo seguinte: a cadeia não cria conflitos.
+    int repair_chain(int min_size, int& source) {
+        const int k = S.k;
+        int budget = opt.repair_budget;
+        mark_token++;
+        queue.clear();
+        for (int c = 0; c < k; ++c) {
+            if (nb_count[c] == 0) {
+                visited[c] = mark_token;
+                depth[c] = 0;
+                parent[c] = -1;
+                queue.push_back(c);
+            }
+        }
+
+        for (size_t h = 0; h < queue.size(); ++h) {
+            int x = queue[h];
+            if (depth[x] >= opt.repair_depth) continue;
+            for (int w : S.classMembers[x]) {
+                if (--budget < 0) return 0;
+                seen_token++;
+                G.for_each_neighbour(w, [&](int u) { seen[S.color[u]] = seen_token; });
+                int off = std::uniform_int_distribution<int>(0, k - 1)(rng);
+                for (int t = 0; t < k; ++t) {
+                    int y = off + t < k ? off + t : off + t - k;
+                    if (visited[y] == mark_token || seen[y] == seen_token) continue;
+                    visited[y] = mark_token;
+                    depth[y] = depth[x] + 1;
+                    parent[y] = x;
+                    mover[y] = w;
+                    if (S.classSize[y] == min_size) {
+                        int moves = 0;
+                        for (int c = y; parent[c] != -1; c = parent[c]) {
+                            S.apply_move(mover[c], c);
+                            source = parent[c];
+                            moves++;
+                        }
+                        return moves;
+                    }
+                    queue.push_back(y);
+                }
+            }
+        }
+        return 0;
+    }
+
+    // ---------- Refinamento (sob o mutex) ----------
+    bool refine_slice() {
+        if (S.obj == 0) return false;
+        if (!started) {
+            S.begin_search(run, cfg, opt.seed);
+            run.persistent = true;
+            started = true;
+        } else if (run.finished) {
+            S.resume_search(run);
+        }
+        int before = run.iter;
+        S.step_search(run, cfg, forever, opt.refine_slice);
+        stats.refine_iterations += run.iter - before;
+
+        // Acima de Delta + 1 cores não há o que ganhar
+        if (S.obj > 0 && S.k < G.max_degree + 1 && run.no_improve_iter >= opt.grow_after) {
+            grow_color();
+            S.resume_search(run);
+        }
+        return S.obj > 0;
+    }
+
+    // Abre a cor k e rebalanceia para k + 1 classes equitativas: cada classe antiga cede o
+    // excedente à nova, primeiro vértices em conflito (saem do conflito), depois os que não
+    // têm vizinhos na nova classe. O(n / k * grau) por abertura (rara).
+    void grow_color() {
+        const int old_k = S.k;
+        S.append_color();
+        resize_scratch();
+        const int c_new = old_k;
+        const int q = S.n / S.k, r = S.n % S.k;
+
+        // As r classes alvo grandes (q + 1) vão para as maiores atuais
+        int big_left = r;
+        for (int c = 0; c < old_k; ++c) {
+            if (S.classSize[c] > q && big_left > 0) {
+                target[c] = q + 1;
+                big_left--;
+            } else {
+                target[c] = q;
+            }
+        }
+        for (int c = 0; c < old_k && big_left > 0; ++c) {
+            if (target[c] == q) {
+                target[c] = q + 1;
+                big_left--;
+            }
+        }
+
+        auto free_in_new = [&](int w) {
+            bool ok = true;
+            G.for_each_neighbour(w, [&](int u) {
+                if (S.color[u] == c_new) ok = false;
+                return ok;
+            });
+            return ok;
+        };
+
+        for (int c = 0; c < old_k; ++c) {
+            int excess = S.classSize[c] - target[c];
+            for (int pass = 0; pass < 3 && excess > 0; ++pass) {
+                // Cópia: apply_move reordena a lista da classe
+                picked.assign(S.classMembers[c].begin(), S.classMembers[c].end());
+                for (int w : picked) {
+                    if (excess == 0) break;
+                    bool take = pass == 0 ? S.conflicts[w] > 0 : pass == 1 ? free_in_new(w) : true;
+                    if (take && S.color[w] == c) {
+                        S.apply_move(w, c_new);
+                        excess--;
+                    }
+                }
+            }
+        }
+        stats.colors_added++;
+    }
+
+    void refine_loop() {
+        std::unique_lock<std::mutex> lk(mu);
+        while (true) {
+            cv.wait(lk, [this] { return stopping || S.obj > 0; });
+            if (stopping) break;
+            refine_slice();
+            // Chegadas esperando passam na frente da próxima fatia
+            lk.unlock();
+            while (waiting.load(std::memory_order_relaxed) > 0) std::this_thread::yield();
+            lk.lock();
+        }
+    }
+
+    void resize_scratch() {
+        const size_t k = S.k;
+        nb_count.resize(k, 0);
+        seen.resize(k, 0);
+        visited.resize(k, 0);
+        depth.resize(k, 0);
+        parent.resize(k, -1);
+        mover.resize(k, -1);
+        target.resize(k, 0);
+        u_count.resize(k, 0);
+    }
+
+    OnlineOptions opt;
+    TabuConfig cfg;
+    DynamicGraph G;
+    BasicSolutionManager<DynamicGraph> S;
+    TabuRun run;
+    bool started = false;
+    StopCriterion forever{1e300};
+    std::mt19937 rng;
+    OnlineStats stats;
+
+    // Rascunho por cor (tamanho k)
+    std::vector<int> nb_count, seen, visited, depth, parent, mover, target, u_count;
+    std::vector<int> queue, picked;
+    int seen_token = 0, mark_token = 0;
+
+    mutable std::mutex mu;
+    std::condition_variable cv;
+    std::atomic<int> waiting{0};
+    bool stopping = false;
+    std::thread worker;
+};
+
+} // namespace tabueqcol
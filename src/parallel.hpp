@@ -0,0 +1,306 @@
+// parallel.hpp
+// C++17 header-only: utilitários mínimos de paralelismo com std::thread
+//
+// Usage example (sketch):
+//   tabueqcol::parallel_for(0, n, [&](long long lo, long long hi, int tid) {
+//       for (long long i = lo; i < hi; ++i) { ... }
+//   });
+//   tabueqcol::parallel_exclusive_scan(counts); // counts[i] -> offset[i], total em counts.back()
+//   tabueqcol::WorkerPool pool(8);              // threads persistentes (uso por iteração)
+//   pool.run(4, [&](int tid) { ... });          // tids 0..3; o chamador executa o tid 0
+//   tabueqcol::ThreadProfile P;                 // opcional: ocupação por thread
+//   tabueqcol::set_thread_profile(&P); ...; P.idle_seconds(tid)
+//
+
+#pragma once
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <algorithm>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <chrono>
+
+namespace tabueqcol {
+
+// ------------------ Perfil de ocupação por thread ------------------
+// Com um perfil instalado (set_thread_profile), cada região paralela (parallel_for,
+// WorkerPool::run) soma, por tid, o tempo de parede da região (span) e o tempo dentro de
+// fn (busy). Ocioso = span - busy: espera pelo bloco mais lento, pela barreira do pool ou
+// por travas dentro de fn. Sem perfil, o custo é uma leitura atômica por região.
+struct ThreadProfile {
+    static constexpr int MAX_THREADS = 256;
+    std::atomic<long long> busy_ns[MAX_THREADS];
+    std::atomic<long long> span_ns[MAX_THREADS];
+    std::atomic<long long> regions{0};
+
+    ThreadProfile() { reset(); }
+
+    void reset() {
+        for (int t = 0; t < MAX_THREADS; ++t) {
+            busy_ns[t].store(0, std::memory_order_relaxed);
+            span_ns[t].store(0, std::memory_order_relaxed);
+        }
+        regions.store(0, std::memory_order_relaxed);
+    }
+
+    void add_busy(int tid, long long ns) {
+        if (tid < MAX_THREADS) busy_ns[tid].fetch_add(ns, std::memory_order_relaxed);
+    }
+
+    void add_region(int threads, long long ns) {
+        for (int t = 0; t < threads && t < MAX_THREADS; ++t) span_ns[t].fetch_add(ns, std::memory_order_relaxed);
+        regions.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    double busy_seconds(int tid) const { return busy_ns[tid].load(std::memory_order_relaxed) * 1e-9; }
+    double span_seconds(int tid) const { return span_ns[tid].load(std::memory_order_relaxed) * 1e-9; }
+    double idle_seconds(int tid) const { return std::max(0.0, span_seconds(tid) - busy_seconds(tid)); }
+
+    static long long now_ns() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+};
+
+inline std::atomic<ThreadProfile*>& thread_profile_slot() {
+    static std::atomic<ThreadProfile*> slot{nullptr};
+    return slot;
+}
+
+// nullptr desinstala. Instalar/desinstalar com regiões paralelas em andamento não é suportado.
+inline void set_thread_profile(ThreadProfile* P) { thread_profile_slot().store(P, std::memory_order_release); }
+
+// Número de threads padrão (hardware_concurrency pode devolver 0)
+inline int default_thread_count() {
+    unsigned h = std::thread::hardware_concurrency();
+    return h == 0 ? 1 : (int)h;
+}
+
+// Executa fn(lo, hi, tid) sobre blocos de [begin, end).
+// Os blocos são distribuídos dinamicamente (contador atômico), o que equilibra
+// a carga quando o custo por item é muito desigual (ex: graus com cauda pesada).
+// threads <= 0 usa default_thread_count(); grain é o tamanho de cada bloco.
+template <class Fn>
+void parallel_for(long long begin, long long end, Fn&& fn, int threads = 0, long long grain = 1 << 14) {
+    long long total = end - begin;
+    if (total <= 0) return;
+    if (threads <= 0) threads = default_thread_count();
+    if (grain < 1) grain = 1;
+
+    long long blocks = (total + grain - 1) / grain;
+    if (blocks < threads) threads = (int)blocks;
+
+    ThreadProfile* prof = thread_profile_slot().load(std::memory_order_acquire);
+    const long long t0 = prof ? ThreadProfile::now_ns() : 0;
+
+    // Pouco trabalho: evita o custo de criar threads
+    if (threads <= 1) {
+        fn(begin, end, 0);
+        if (prof) {
+            long long w = ThreadProfile::now_ns() - t0;
+            prof->add_busy(0, w);
+            prof->add_region(1, w);
+        }
+        return;
+    }
+
+    std::atomic<long long> next(0);
+    auto worker = [&](int tid) {
+        while (true) {
+            long long b = next.fetch_add(1, std::memory_order_relaxed);
+            if (b >= blocks) break;
+            long long lo = begin + b * grain;
+            long long hi = std::min(end, lo + grain);
+            if (prof) {
+                long long b0 = ThreadProfile::now_ns();
+                fn(lo, hi, tid);
+                prof->add_busy(tid, ThreadProfile::now_ns() - b0);
+            } else {
+                fn(lo, hi, tid);
+            }
+        }
+    };
+
+    std::vector<std::thread> pool;
+    pool.reserve(threads - 1);
+    for (int t = 1; t < threads; ++t) pool.emplace_back(worker, t);
+    worker(0);
+    for (auto &th : pool) th.join();
+    if (prof) prof->add_region(threads, ThreadProfile::now_ns() - t0);
+}
+
+// Soma de prefixo exclusiva in-place em paralelo (duas passadas por blocos).
+// Entrada: values[0..n-1] com contagens, values.size() == n + 1.
+// Saída:   values[i] = soma(values[0..i-1]) e values[n] = total.
+template <class T>
+void parallel_exclusive_scan(std::vector<T>& values, int threads = 0) {
+    if (values.empty()) return;
+    long long n = (long long)values.size() - 1;
+    if (threads <= 0) threads = default_thread_count();
+
+    const long long min_block = 1 << 16;
+    long long nblocks = std::min<long long>(threads, (n + min_block - 1) / min_block);
+
+    if (nblocks <= 1) {
+        T acc = 0;
+        for (long long i = 0; i < n; ++i) {
+            T x = values[i];
+            values[i] = acc;
+            acc += x;
+        }
+        values[n] = acc;
+        return;
+    }
+
+    long long block = (n + nblocks - 1) / nblocks;
+    std::vector<T> block_sum(nblocks + 1, 0);
+
+    // 1. Soma de cada bloco
+    parallel_for(0, nblocks, [&](long long lo, long long hi, int) {
+        for (long long b = lo; b < hi; ++b) {
+            T s = 0;
+            long long e = std::min(n, (b + 1) * block);
+            for (long long i = b * block; i < e; ++i) s += values[i];
+            block_sum[b] = s;
+        }
+    }, (int)nblocks, 1);
+
+    // 2. Prefixo (serial) sobre os totais dos blocos
+    T acc = 0;
+    for (long long b = 0; b < nblocks; ++b) {
+        T x = block_sum[b];
+        block_sum[b] = acc;
+        acc += x;
+    }
+
+    // 3. Prefixo local de cada bloco deslocado pelo total anterior
+    parallel_for(0, nblocks, [&](long long lo, long long hi, int) {
+        for (long long b = lo; b < hi; ++b) {
+            T s = block_sum[b];
+            long long e = std::min(n, (b + 1) * block);
+            for (long long i = b * block; i < e; ++i) {
+                T x = values[i];
+                values[i] = s;
+                s += x;
+            }
+        }
+    }, (int)nblocks, 1);
+
+    values[n] = acc;
+}
+
+// Pool de threads persistente para trabalho de granularidade fina (ex: uma varredura
+// de vizinhança por iteração do tabu). Criar std::thread a cada iteração custaria mais
+// que a própria varredura; aqui os workers ficam em espera ativa curta e depois dormem.
+class WorkerPool {
+public:
+    // threads: total, incluindo o chamador (que executa o tid 0)
+    explicit WorkerPool(int threads) : total(std::max(1, threads)) {
+        for (int t = 1; t < total; ++t) workers.emplace_back(&WorkerPool::worker_loop, this, t);
+    }
+
+    ~WorkerPool() {
+        {
+            std::lock_guard<std::mutex> lk(mu);
+            stopping.store(true);
+        }
+        cv_start.notify_all();
+        for (auto &th : workers) th.join();
+    }
+
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+
+    int size() const { return total; }
+
+    // Executa fn(tid) para tid em [0, active) e só retorna quando todos terminarem
+    void run(int active_threads, const std::function<void(int)>& fn) {
+        active_threads = std::max(1, std::min(active_threads, total));
+        ThreadProfile* prof = thread_profile_slot().load(std::memory_order_acquire);
+        const long long t0 = prof ? ThreadProfile::now_ns() : 0;
+        profile = prof;
+        if (active_threads == 1) {
+            fn(0);
+            if (prof) {
+                long long w = ThreadProfile::now_ns() - t0;
+                prof->add_busy(0, w);
+                prof->add_region(1, w);
+            }
+            return;
+        }
+        task = &fn;
+        pending.store(active_threads - 1, std::memory_order_relaxed);
+        {
+            // geração e número de threads ativas num único atômico: um worker nunca
+            // combina a geração antiga com o "active" da nova
+            std::lock_guard<std::mutex> lk(mu);
+            generation++;
+            ticket.store((generation << 16) | active_threads, std::memory_order_release);
+        }
+        cv_start.notify_all();
+
+        if (prof) {
+            long long b0 = ThreadProfile::now_ns();
+            fn(0);
+            prof->add_busy(0, ThreadProfile::now_ns() - b0);
+        } else {
+            fn(0);
+        }
+
+        // Espera os demais: espera ativa curta, depois bloqueia
+        for (int spin = 0; pending.load(std::memory_order_acquire) != 0; ++spin) {
+            if (spin < SPIN_LIMIT) continue;
+            std::unique_lock<std::mutex> lk(mu);
+            cv_done.wait(lk, [&] { return pending.load(std::memory_order_acquire) == 0; });
+        }
+        task = nullptr;
+        if (prof) prof->add_region(active_threads, ThreadProfile::now_ns() - t0);
+    }
+
+private:
+    static constexpr int SPIN_LIMIT = 1 << 14;
+
+    void worker_loop(int tid) {
+        long long seen = 0;
+        while (true) {
+            long long t;
+            for (int spin = 0; ((t = ticket.load(std::memory_order_acquire)) >> 16) == seen && !stopping.load(); ++spin) {
+                if (spin < SPIN_LIMIT) continue;
+                std::unique_lock<std::mutex> lk(mu);
+                cv_start.wait(lk, [&] { return (ticket.load(std::memory_order_acquire) >> 16) != seen || stopping.load(); });
+            }
+            if (stopping.load()) return;
+            seen = t >> 16;
+
+            if (tid < (int)(t & 0xFFFF)) {
+                // 'profile' foi escrito antes do ticket (release) e é lido depois (acquire)
+                if (ThreadProfile* prof = profile) {
+                    long long b0 = ThreadProfile::now_ns();
+                    (*task)(tid);
+                    prof->add_busy(tid, ThreadProfile::now_ns() - b0);
+                } else {
+                    (*task)(tid);
+                }
+                if (pending.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                    std::lock_guard<std::mutex> lk(mu);
+                    cv_done.notify_one();
+                }
+            }
+        }
+    }
+
+    int total;
+    std::vector<std::thread> workers;
+    std::mutex mu;
+    std::condition_variable cv_start, cv_done;
+    const std::function<void(int)>* task = nullptr;
+    ThreadProfile* profile = nullptr;   // perfil da rodada atual (escrito junto com task)
+    long long generation = 0;           // só o chamador de run() altera
+    std::atomic<long long> ticket{0};   // (geração << 16) | threads ativas
+    std::atomic<int> pending{0};
+    std::atomic<bool> stopping{false};
+};
+
+} // namespace tabueqcol
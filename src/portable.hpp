@@ -0,0 +1,149 @@
+// portable.hpp
+// C++17 header-only: o pouco que depende do sistema ou do compilador, atrás de funções próprias
+//
+// Usage example (sketch):
+//   int i = tabueqcol::ctz64(mask), c = tabueqcol::popcount64(mask);   // mask != 0 em ctz64
+//   double t = tabueqcol::process_cpu_seconds();                        // e thread_cpu_seconds()
+//   long long p = tabueqcol::page_size_bytes();
+//   tabueqcol::RawFile f(path); f.read_at(buf, bytes, offset);          // leitura posicional
+//
+// POSIX (Linux, macOS, MinGW com winpthreads) e MSVC. O resto do código não inclui
+// cabeçalhos de sistema nem usa intrínsecos de um compilador só; o que não existe numa
+// plataforma degrada para "indisponível" (por exemplo, RSS 0 fora do Linux).
+
+#pragma once
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <stdexcept>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#include <fcntl.h>
+#include <io.h>
+#else
+#include <fcntl.h>
+#include <time.h>
+#include <unistd.h>
+#endif
+
+namespace tabueqcol {
+
+// ------------------ Bits ------------------
+inline int ctz64(uint64_t x) {
+#if defined(_MSC_VER)
+    unsigned long i;
+    _BitScanForward64(&i, x);
+    return (int)i;
+#else
+    return __builtin_ctzll(x);
+#endif
+}
+
+inline int popcount64(uint64_t x) {
+#if defined(_MSC_VER)
+    return (int)__popcnt64(x);
+#else
+    return __builtin_popcountll(x);
+#endif
+}
+
+// ------------------ Relógios de CPU ------------------
+#if defined(_WIN32)
+inline double filetime_seconds(const FILETIME& kernel, const FILETIME& user) {
+    auto ticks = [](const FILETIME& f) { return ((uint64_t)f.dwHighDateTime << 32) | f.dwLowDateTime; };
+    return 1e-7 * (double)(ticks(kernel) + ticks(user)); // unidades de 100 ns
+}
+#else
+inline double clock_seconds(clockid_t id) {
+    timespec ts;
+    clock_gettime(id, &ts);
+    return (double)ts.tv_sec + 1e-9 * (double)ts.tv_nsec;
+}
+#endif
+
+// Segundos de CPU do processo (todas as threads)
+inline double process_cpu_seconds() {
+#if defined(_WIN32)
+    FILETIME creation, exit, kernel, user;
+    GetProcessTimes(GetCurrentProcess(), &creation, &exit, &kernel, &user);
+    return filetime_seconds(kernel, user);
+#else
+    return clock_seconds(CLOCK_PROCESS_CPUTIME_ID);
+#endif
+}
+
+// Segundos de CPU da thread que chama
+inline double thread_cpu_seconds() {
+#if defined(_WIN32)
+    FILETIME creation, exit, kernel, user;
+    GetThreadTimes(GetCurrentThread(), &creation, &exit, &kernel, &user);
+    return filetime_seconds(kernel, user);
+#else
+    return clock_seconds(CLOCK_THREAD_CPUTIME_ID);
+#endif
+}
+
+// ------------------ Memória ------------------
+inline long long page_size_bytes() {
+#if defined(_WIN32)
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return (long long)info.dwPageSize;
+#else
+    return (long long)sysconf(_SC_PAGESIZE);
+#endif
+}
+
+// ------------------ Arquivo com leitura posicional ------------------
+// Um leitor por vez (a thread de pré-busca de external.hpp): no Windows read_at é um
+// seek seguido de read, sem o pread atômico do POSIX.
+class RawFile {
+public:
+    explicit RawFile(const std::string& path) {
+#if defined(_WIN32)
+        fd = _open(path.c_str(), _O_RDONLY | _O_BINARY);
+#else
+        fd = open(path.c_str(), O_RDONLY);
+#endif
+        if (fd < 0) throw std::runtime_error("Cannot open file: " + path);
+    }
+
+    ~RawFile() {
+#if defined(_WIN32)
+        _close(fd);
+#else
+        close(fd);
+#endif
+    }
+
+    RawFile(const RawFile&) = delete;
+    RawFile& operator=(const RawFile&) = delete;
+
+    // Bytes lidos (0 no fim do arquivo, negativo em erro)
+    long long read_at(void* dst, size_t bytes, long long offset) {
+#if defined(_WIN32)
+        if (_lseeki64(fd, offset, SEEK_SET) < 0) return -1;
+        return _read(fd, dst, (unsigned)std::min<size_t>(bytes, 1u << 30));
+#else
+        return (long long)pread(fd, dst, bytes, (off_t)offset);
+#endif
+    }
+
+    // Aviso de leitura sequencial ao sistema, onde existe
+    void advise_sequential() {
+#ifdef POSIX_FADV_SEQUENTIAL
+        posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif
+    }
+
+private:
+    int fd = -1;
+};
+
+} // namespace tabueqcol
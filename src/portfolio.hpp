@@ -0,0 +1,275 @@
+// portfolio.hpp
+// C++17 header-only: portfólio de variantes do solver competindo pelo mesmo k (modo portfólio)
+//
+// Usage example (sketch):
+//   auto P = tabueqcol::run_portfolio(inst, config, stop, seed, max_iter, threads);
+//   P.descent.best.color / P.descent.best_k      // mesma interface de run_descent
+//   P.engines[i].name / wins / slices            // quem fechou cada k e quanto tempo recebeu
+//
+// Cada motor é uma busca retomável (TabuRun) com configuração própria:
+//   tabu      a descida padrão (k - 1 a partir da melhor coloração compartilhada)
+//   restart   reinícios aleatórios: construção do zero em k - 1, orçamento curto por tentativa
+//   perturb   perturbação agressiva (limite curto, força alta)
+//   sampled / first / full   as outras vizinhanças (a que a configuração base não usa)
+// Todos atacam o mesmo alvo: um abaixo do melhor k compartilhado. Quem fecha publica a
+// coloração e os demais abandonam a tentativa em andamento na próxima fatia.
+//
+// As threads executam fatias de ~20 ms (até 'slice' iterações). O tempo de CPU é repartido por
+// passo (stride scheduling): cada motor acumula tempo_gasto / peso e a próxima fatia vai
+// ao motor livre com o menor acumulado, então a fração de CPU de cada um é proporcional
+// ao peso, mesmo com fatias de custo muito diferente entre vizinhanças. Peso = piso fixo
+// + crédito recente (redução relativa do melhor f da tentativa, bônus ao fechar um k,
+// decaimento a cada fatia do portfólio): a CPU migra para quem está produzindo melhora
+// sem zerar a exploração dos demais. Com uma thread, vira um rodízio ponderado.
+
+#pragma once
+#include "descent.hpp"
+#include <mutex>
+#include <string>
+#include <vector>
+#include <memory>
+#include <thread>
+
+namespace tabueqcol {
+
+struct PortfolioEngineStats {
+    std::string name;
+    long long slices = 0;      // fatias executadas (a fatia de CPU recebida)
+    long long iterations = 0;
+    int attempts = 0;          // buscas iniciadas
+    int wins = 0;              // ks fechados por este motor
+    double score = 0.0;        // crédito ao fim (peso = piso + score)
+};
+
+template <class Graph>
+struct PortfolioResult {
+    DescentResult<Graph> descent;
+    std::vector<PortfolioEngineStats> engines;
+};
+
+// Motores padrão a partir da configuração base
+inline std::vector<std::pair<std::string, TabuConfig>> default_portfolio(const TabuConfig& base) {
+    std::vector<std::pair<std::string, TabuConfig>> E;
+    TabuConfig c = base;
+    c.threads = 1; // o paralelismo é entre motores
+    E.push_back({"tabu", c});
+
+    TabuConfig r = c;
+    r.max_iter = std::max(1000, c.max_iter / 8);
+    E.push_back({"restart", r});
+
+    TabuConfig p = c;
+    p.perturbation_limit = std::max(50, c.perturbation_limit / 5);
+    p.perturbation_strength = std::max(0.35, c.perturbation_strength);
+    E.push_back({"perturb", p});
+
+    static const char* scan_names[] = {"full", "sampled", "first"};
+    for (int mode = 0; mode < 3; ++mode) {
+        if (mode == c.scan_mode) continue;
+        TabuConfig s = c;
+        s.scan_mode = mode;
+        s.block_scan = mode == 0 ? c.block_scan : 0;
+        E.push_back({scan_names[mode], s});
+    }
+    return E;
+}
+
+template <class Graph>
+class Portfolio {
+public:
+    Portfolio(const Graph& g, const std::vector<std::pair<std::string, TabuConfig>>& configs, int seed)
+        : graph(&g), seed(seed) {
+        for (size_t i = 0; i < configs.size(); ++i) {
+            engines.emplace_back(new Engine());
+            engines[i]->stats.name = configs[i].first;
+            engines[i]->config = configs[i].second;
+            engines[i]->index = (int)i;
+            engines[i]->restart = configs[i].first == "restart";
+        }
+        // SI: Delta + 1; o primeiro alvo é ele mesmo (a construção gulosa pode ter conflitos)
+        D.initial_k = g.max_degree + 1;
+        D.best_k = D.initial_k + 1;
+    }
+
+    PortfolioResult<Graph> run(const StopCriterion& stop, int threads, long long slice) {
+        if (threads <= 0) threads = default_thread_count();
+        threads = std::min<int>(threads, (int)engines.size());
+        slice = std::max(1LL, slice);
+
+        parallel_for(0, threads, [&](long long, long long, int) {
+            while (!stop.is_time_up()) {
+                Engine* e = acquire();
+                if (!e) {
+                    if (done()) break;
+                    std::this_thread::yield(); // todos os motores ocupados
+                    continue;
+                }
+                double t0 = stop.get_elapsed();
+                double reward = step(*e, stop, slice);
+                release(*e, stop.get_elapsed() - t0, reward);
+            }
+        }, threads, 1);
+
+        PortfolioResult<Graph> R;
+        for (auto& e : engines) {
+            if (e->running) {
+                e->current.finish_search(e->run, e->config);
+                e->stats.iterations += e->run.iter;
+            }
+            e->stats.score = e->score;
+            R.engines.push_back(e->stats);
+            D.total_iterations += e->stats.iterations;
+        }
+        if (D.best_k > D.initial_k) {
+            // Nenhum k fechou: devolve a construção inicial, como a descida sem sucesso
+            D.best_k = D.initial_k;
+            D.best = BasicSolutionManager<Graph>(*graph, D.initial_k);
+            D.best.construct_greedy_initial(seed);
+        }
+        R.descent = std::move(D);
+        return R;
+    }
+
+private:
+    struct Engine {
+        int index = 0;
+        TabuConfig config;
+        bool restart = false;
+        BasicSolutionManager<Graph> current;
+        TabuRun run;
+        bool running = false;
+        int target_k = 0;
+        long long attempt_best = 0; // melhor f da tentativa (base do crédito)
+        bool busy = false;
+        double score = 0.0;
+        double vtime = 0.0;         // segundos de CPU / peso (stride scheduling)
+        long long slice_iters = 8;  // iterações da próxima fatia (começa com uma sonda curta)
+        PortfolioEngineStats stats;
+    };
+
+    static constexpr double FLOOR_WEIGHT = 0.25; // exploração mínima de cada motor
+    static constexpr double DECAY = 0.9;         // crédito por fatia
+    static constexpr double WIN_BONUS = 4.0;
+    static constexpr double SLICE_SECONDS = 0.02;
+
+    bool done() {
+        std::lock_guard<std::mutex> lk(mu);
+        return D.best_k == 1;
+    }
+
+    double weight(const Engine& e) const { return FLOOR_WEIGHT + e.score; }
+
+    // Motor livre com o menor tempo virtual
+    Engine* acquire() {
+        std::lock_guard<std::mutex> lk(mu);
+        if (D.best_k == 1) return nullptr;
+        Engine* pick = nullptr;
+        for (auto& e : engines) {
+            if (!e->busy && (!pick || e->vtime < pick->vtime)) pick = e.get();
+        }
+        if (pick) pick->busy = true;
+        return pick;
+    }
+
+    // Fecha a fatia: cobra o tempo com o peso vigente e credita a melhora da fatia
+    void release(Engine& e, double seconds, double reward) {
+        std::lock_guard<std::mutex> lk(mu);
+        e.vtime += seconds / weight(e);
+        e.busy = false;
+        for (auto& other : engines) other->score *= DECAY;
+        e.score += reward;
+    }
+
+    // Nova tentativa em (melhor k compartilhado) - 1
+    void start_attempt(Engine& e) {
+        int attempt_seed = seed + 7919 * e.index + 104729 * e.stats.attempts;
+        // Sob a trava só a cópia da base; a construção (O(n + m)) não segura os outros motores
+        BasicSolutionManager<Graph> base;
+        bool from_previous;
+        {
+            std::lock_guard<std::mutex> lk(mu);
+            e.target_k = D.best_k - 1;
+            if (e.target_k < 1) return;
+            from_previous = !e.restart && D.best_k <= D.initial_k;
+            if (from_previous) base = D.best;
+        }
+        e.current = BasicSolutionManager<Graph>(*graph, e.target_k);
+        if (from_previous) {
+            e.current.construct_greedy_from_previous(base, attempt_seed);
+        } else {
+            e.current.construct_greedy_initial(attempt_seed);
+        }
+        e.current.begin_search(e.run, e.config, attempt_seed);
+        e.attempt_best = e.current.obj;
+        e.running = true;
+        e.stats.attempts++;
+    }
+
+    // Uma fatia do motor; devolve o crédito ganho nela
+    double step(Engine& e, const StopCriterion& stop, long long slice) {
+        e.stats.slices++;
+        double reward = 0.0;
+
+        int shared_k;
+        {
+            std::lock_guard<std::mutex> lk(mu);
+            shared_k = D.best_k;
+        }
+        if (e.running && e.target_k >= shared_k) {
+            // Outro motor fechou este k (ou um menor): a tentativa perdeu o sentido
+            e.current.finish_search(e.run, e.config);
+            e.stats.iterations += e.run.iter;
+            e.running = false;
+        }
+        if (!e.running) {
+            start_attempt(e);
+            if (!e.running) return reward;
+        }
+
+        // Fatia em iterações ajustada ao custo observado: ~SLICE_SECONDS por fatia, no máximo
+        // 'slice' iterações (uma iteração da varredura completa com muitos conflitos pode
+        // custar milissegundos, a da amostrada microssegundos)
+        int before = e.run.iter;
+        double t0 = stop.get_elapsed();
+        bool ended = e.current.step_search(e.run, e.config, stop, std::min<long long>(slice, e.slice_iters));
+        double per_iter = (stop.get_elapsed() - t0) / std::max(1, e.run.iter - before);
+        e.slice_iters = (long long)std::max(1.0, std::min<double>((double)slice, SLICE_SECONDS / std::max(per_iter, 1e-9)));
+        int best_now = e.run.finished ? (int)e.run.result.final_obj : e.run.best_obj_found;
+        if (best_now < e.attempt_best) {
+            reward += (double)(e.attempt_best - best_now) / (double)std::max<long long>(1, e.attempt_best);
+            e.attempt_best = best_now;
+        }
+        if (!ended) return reward;
+
+        e.running = false;
+        e.stats.iterations += e.run.iter;
+        if (!e.run.result.solved) return reward; // orçamento da tentativa esgotado: recomeça com outra semente
+
+        std::lock_guard<std::mutex> lk(mu);
+        if (e.current.k < D.best_k) {
+            D.best = e.current;
+            D.best_k = e.current.k;
+            if (e.config.metrics) e.config.metrics->best_k.store(D.best_k, std::memory_order_relaxed);
+            e.stats.wins++;
+            reward += WIN_BONUS;
+        }
+        return reward;
+    }
+
+    const Graph* graph;
+    int seed;
+    std::vector<std::unique_ptr<Engine>> engines;
+    std::mutex mu;           // melhor solução compartilhada, pesos e ocupação dos motores
+    DescentResult<Graph> D;
+};
+
+template <class Graph>
+inline PortfolioResult<Graph> run_portfolio(const Graph& g, const TabuConfig& config, const StopCriterion& stop,
+                                            int seed, long long max_iter, int threads = 0, long long slice = 256) {
+    TabuConfig base = config;
+    base.max_iter = (int)std::min<long long>(max_iter, std::numeric_limits<int>::max());
+    Portfolio<Graph> P(g, default_portfolio(base), seed);
+    return P.run(stop, threads, slice);
+}
+
+} // namespace tabueqcol
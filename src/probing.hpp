@@ -0,0 +1,131 @@
+// probing.hpp
+// C++17 header-only: sondagem de k abaixo da primeira falha (perfil de factibilidade)
+//
+// Usage example (sketch):
+//   auto D = tabueqcol::run_probing_descent(inst, config, stop, seed, max_iter, depth, threads);
+//   D.best.color / D.best_k                        // mesma interface de run_descent
+//   for (auto& p : tabueqcol::feasibility_profile(D)) ...  // k, resolvido/falhou, tentativas
+//
+// A colorabilidade equitativa não é monótona em k: um grafo pode ter coloração equitativa
+// com k cores e não com k + 1 (K_{3,3}: 2 e 4 sim, 3 não). A descida de descent.hpp para
+// na primeira falha; aqui, depois dela, as threads sondam os k logo abaixo (até 'depth'
+// níveis sob o melhor resolvido), uma busca tabu por k, cada uma construída a partir da
+// melhor solução conhecida (remoções sucessivas de classe pela regra M da construção).
+// Uma rodada que resolve algum k move a base para o menor deles e as sondagens recomeçam
+// logo abaixo; uma rodada sem sucesso desce a janela. Para quando a janela passa de
+// best_k - depth ou o tempo esgota. A busca que falha na descida consome o restante de
+// max_iter (orçamento total da descida); cada sondagem recebe max_iter iterações próprias
+// e o limite conjunto é o tempo.
+
+#pragma once
+#include "descent.hpp"
+#include <algorithm>
+#include <limits>
+#include <map>
+#include <vector>
+
+namespace tabueqcol {
+
+// Resumo por k das tentativas registradas no perfil
+struct KFeasibility {
+    int k = 0;
+    bool solved = false;       // alguma tentativa fechou este k
+    int attempts = 0;
+    long long iterations = 0;
+    long long best_obj = 0;    // menor f final entre as tentativas
+};
+
+template <class Graph>
+inline std::vector<KFeasibility> feasibility_profile(const DescentResult<Graph>& D) {
+    std::map<int, KFeasibility> by_k;
+    for (const auto& a : D.profile) {
+        auto it = by_k.find(a.k);
+        if (it == by_k.end()) {
+            KFeasibility f;
+            f.k = a.k;
+            f.best_obj = a.final_obj;
+            it = by_k.emplace(a.k, f).first;
+        }
+        KFeasibility& f = it->second;
+        f.solved = f.solved || a.solved;
+        f.attempts++;
+        f.iterations += a.iterations;
+        f.best_obj = std::min(f.best_obj, a.final_obj);
+    }
+    std::vector<KFeasibility> P;
+    for (auto it = by_k.rbegin(); it != by_k.rend(); ++it) P.push_back(it->second); // k decrescente
+    return P;
+}
+
+// Solução inicial em 'target' < base.k: remove uma classe por vez a partir da base
+template <class Graph>
+inline BasicSolutionManager<Graph> construct_below(const Graph& g, const BasicSolutionManager<Graph>& base,
+                                                   int target, int seed) {
+    BasicSolutionManager<Graph> prev = base;
+    while (prev.k > target) {
+        BasicSolutionManager<Graph> next(g, prev.k - 1);
+        next.construct_greedy_from_previous(prev, seed);
+        prev = std::move(next);
+    }
+    return prev;
+}
+
+template <class Graph>
+inline DescentResult<Graph> run_probing_descent(const Graph& g, TabuConfig config, const StopCriterion& stop,
+                                                int seed, long long max_iter, int depth, int threads = 0) {
+    // --- DESCIDA PADRÃO até a primeira falha ---
+    DescentJob<Graph> job(g, config, seed, max_iter);
+    job.step(stop);
+    DescentResult<Graph> D = std::move(job.result());
+    // Sem nenhum k resolvido não há base factível para as construções
+    if (depth <= 0 || D.profile.empty() || !D.profile.front().solved) return D;
+
+    if (threads <= 0) threads = default_thread_count();
+    const int width = std::max(1, std::min(threads, depth));
+    // As threads vão para as sondagens; o que sobrar fica na varredura de cada uma
+    TabuConfig probe_config = config;
+    probe_config.threads = std::max(1, config.threads / width);
+
+    // --- SONDAGEM ABAIXO DA FALHA ---
+    // A descida acabou de falhar em best_k - 1 a partir da base atual
+    int lowest_tried = D.best_k - 1;
+    while (!stop.is_time_up()) {
+        std::vector<int> targets;
+        for (int k = lowest_tried - 1; k >= std::max(1, D.best_k - depth) && (int)targets.size() < width; --k) {
+            targets.push_back(k);
+        }
+        if (targets.empty()) break;
+        lowest_tried = targets.back();
+
+        const int P = (int)targets.size();
+        TabuConfig c = probe_config;
+        c.max_iter = (int)std::min<long long>(max_iter, std::numeric_limits<int>::max());
+        std::vector<BasicSolutionManager<Graph>> S(P);
+        std::vector<TabuResult> R(P);
+        parallel_for(0, P, [&](long long lo, long long hi, int) {
+            for (long long i = lo; i < hi; ++i) {
+                // D.best não muda durante a rodada: leitura compartilhada
+                int probe_seed = seed + 7919 * targets[i];
+                S[i] = construct_below(g, D.best, targets[i], probe_seed);
+                R[i] = S[i].run_tabu_search(c, stop, probe_seed);
+            }
+        }, P, 1);
+
+        int winner = -1;
+        for (int i = 0; i < P; ++i) {
+            D.total_iterations += R[i].iterations;
+            D.profile.push_back({targets[i], R[i].solved, R[i].iterations, R[i].final_obj, R[i].search_seconds});
+            if (R[i].solved && (winner < 0 || targets[i] < targets[winner])) winner = i;
+        }
+        if (winner >= 0) {
+            // Nova base: as próximas sondagens começam logo abaixo dela
+            D.best = std::move(S[winner]);
+            D.best_k = D.best.k;
+            lowest_tried = D.best_k;
+            if (config.metrics) config.metrics->best_k.store(D.best_k, std::memory_order_relaxed);
+        }
+    }
+    return D;
+}
+
+} // namespace tabueqcol
@@ -0,0 +1,271 @@
+// recombination.hpp
+// C++17 header-only: recombinação das classes do pool por particionamento de conjuntos
+//
+// Usage example (sketch):
+//   auto P = tabueqcol::run_pool_descent(inst, config, stop, seed, max_iter, rounds);
+//   P.descent.best.color / P.descent.best_k      // mesma interface de run_descent
+//   P.pool_classes / P.exact / P.closed          // tamanho do pool e o que a recombinação fechou
+//
+// A descida padrão roda com um ClassPool ligado (class_pool.hpp): cada busca deposita as
+// suas classes sem conflito, inclusive a que falha em best_k - 1. Depois da falha, cada
+// rodada escolhe k = best_k - 1 classes do pool com tamanhos floor(n/k) ou ceil(n/k) que
+// cobrem V exatamente (SetPartition: branch-and-bound com limite de nós). Sem cobertura
+// exata fica a maior cobertura parcial vista; os vértices descobertos vão para as classes
+// que faltam (menos vizinhos primeiro) e uma busca tabu curta fecha as lacunas. Um k fechado
+// vira a nova base da descida padrão (que colhe classes do tamanho do próximo alvo);
+// 'rounds' rodadas sem sucesso no mesmo k encerram.
+
+#pragma once
+#include "descent.hpp"
+#include "class_pool.hpp"
+#include <algorithm>
+#include <limits>
+#include <random>
+#include <vector>
+
+namespace tabueqcol {
+
+// Resultado do particionamento: índices das classes escolhidas
+struct PartitionResult {
+    std::vector<int> chosen; // exata: k classes que cobrem V; senão a maior cobertura parcial vista
+    int covered = 0;
+    bool exact = false;
+    long long nodes = 0;
+};
+
+// Escolhe k classes de C (exatamente n mod k de tamanho f + 1, o resto de tamanho f) disjuntas
+// e cobrindo V. Ramifica no vértice descoberto com menos classes disponíveis (disjuntas de
+// tudo o que já foi escolhido); vértice sem nenhuma poda o ramo. 'avail' e 'blocked' são
+// mantidos incrementalmente ao escolher/desfazer uma classe. As listas por vértice são
+// embaralhadas por 'rng': rodadas diferentes exploram ramos diferentes dentro do limite.
+class SetPartition {
+public:
+    SetPartition(const std::vector<std::vector<int>>& C, int n, int k, std::mt19937& rng)
+        : C(C), n(n), f(n / k), left_big(n % k), left_small(k - n % k),
+          containing(n), blocked(C.size(), 0), avail(n, 0), covered(n, 0) {
+        for (int i = 0; i < (int)C.size(); ++i) {
+            for (int v : C[i]) containing[v].push_back(i);
+        }
+        for (int v = 0; v < n; ++v) {
+            std::shuffle(containing[v].begin(), containing[v].end(), rng);
+            avail[v] = (int)containing[v].size();
+        }
+    }
+
+    PartitionResult solve(long long node_limit, const StopCriterion& stop) {
+        limit = node_limit;
+        this->stop = &stop;
+        PartitionResult R;
+        R.exact = dfs();
+        R.chosen = R.exact ? stack : best;
+        R.covered = R.exact ? n : best_covered;
+        R.nodes = nodes;
+        return R;
+    }
+
+private:
+    bool fits(int i) const {
+        int s = (int)C[i].size();
+        return (s == f + 1 && left_big > 0) || (s == f && left_small > 0);
+    }
+
+    void take(int i) {
+        for (int v : C[i]) {
+            covered[v] = 1;
+            for (int d : containing[v]) {
+                if (blocked[d]++ == 0) {
+                    for (int u : C[d]) avail[u]--;
+                }
+            }
+        }
+        num_covered += (int)C[i].size();
+        if ((int)C[i].size() == f + 1) left_big--; else left_small--;
+        stack.push_back(i);
+    }
+
+    void undo(int i) {
+        stack.pop_back();
+        if ((int)C[i].size() == f + 1) left_big++; else left_small++;
+        num_covered -= (int)C[i].size();
+        for (int v : C[i]) {
+            covered[v] = 0;
+            for (int d : containing[v]) {
+                if (--blocked[d] == 0) {
+                    for (int u : C[d]) avail[u]++;
+                }
+            }
+        }
+    }
+
+    bool dfs() {
+        if (++nodes > limit || ((nodes & 1023) == 0 && stop->is_time_up())) {
+            aborted = true;
+            return false;
+        }
+        if (num_covered > best_covered) {
+            best_covered = num_covered;
+            best = stack;
+        }
+        if (left_big + left_small == 0) return num_covered == n;
+
+        int pick = -1;
+        for (int v = 0; v < n; ++v) {
+            if (covered[v]) continue;
+            if (pick < 0 || avail[v] < avail[pick]) pick = v;
+            if (avail[pick] == 0) return false;
+        }
+        if (pick < 0) return false;
+
+        for (int d : containing[pick]) {
+            if (blocked[d] != 0 || !fits(d)) continue;
+            take(d);
+            if (dfs()) return true;
+            undo(d);
+            if (aborted) return false;
+        }
+        return false;
+    }
+
+    const std::vector<std::vector<int>>& C;
+    int n, f;
+    int left_big, left_small;
+    std::vector<std::vector<int>> containing; // classes que contêm cada vértice
+    std::vector<int> blocked;                 // vértices já cobertos em cada classe
+    std::vector<int> avail;                   // classes com blocked == 0 que contêm cada vértice
+    std::vector<char> covered;
+    int num_covered = 0;
+    std::vector<int> stack, best;
+    int best_covered = -1;
+    long long nodes = 0, limit = 0;
+    bool aborted = false;
+    const StopCriterion* stop = nullptr;
+};
+
+// Solução em k com as classes escolhidas fixadas nas cores 0..|chosen|-1; os descobertos vão,
+// em ordem aleatória, para a cor restante com capacidade e menos vizinhos já nela
+template <class Graph>
+inline BasicSolutionManager<Graph> assemble_from_classes(const Graph& g, int k, const std::vector<std::vector<int>>& C,
+                                                         const std::vector<int>& chosen, int seed) {
+    const int n = g.n, f = n / k;
+    int big_left = n - k * f;
+    std::vector<int> color(n, -1);
+    int used = 0;
+    for (int i : chosen) {
+        for (int v : C[i]) color[v] = used;
+        if ((int)C[i].size() == f + 1) big_left--;
+        used++;
+    }
+    std::vector<int> cap(k, 0);
+    for (int j = used; j < k; ++j) {
+        cap[j] = f + (big_left > 0 ? 1 : 0);
+        if (big_left > 0) big_left--;
+    }
+
+    std::vector<int> rest;
+    for (int v = 0; v < n; ++v) {
+        if (color[v] < 0) rest.push_back(v);
+    }
+    std::mt19937 rng(seed);
+    std::shuffle(rest.begin(), rest.end(), rng);
+    std::vector<int> cnt(k, 0), touched;
+    for (int v : rest) {
+        g.for_each_neighbour(v, [&](int u) {
+            int c = color[u];
+            if (c >= used && cnt[c]++ == 0) touched.push_back(c);
+        });
+        int best = -1;
+        for (int j = used; j < k; ++j) {
+            if (cap[j] > 0 && (best < 0 || cnt[j] < cnt[best])) best = j;
+        }
+        color[v] = best;
+        cap[best]--;
+        for (int c : touched) cnt[c] = 0;
+        touched.clear();
+    }
+
+    BasicSolutionManager<Graph> S(g, k);
+    S.compute_from_coloring(color);
+    return S;
+}
+
+template <class Graph>
+struct PoolDescentResult {
+    DescentResult<Graph> descent;
+    size_t pool_classes = 0; // classes no pool ao fim
+    int partitions = 0;      // rodadas de recombinação
+    int exact = 0;           // rodadas com cobertura exata de V
+    int closed = 0;          // ks fechados pela recombinação
+};
+
+template <class Graph>
+inline PoolDescentResult<Graph> run_pool_descent(const Graph& g, TabuConfig config, const StopCriterion& stop,
+                                                 int seed, long long max_iter, int rounds,
+                                                 long long node_limit = 200000) {
+    ClassPool pool;
+    config.class_pool = &pool;
+
+    // --- DESCIDA PADRÃO até a primeira falha (enchendo o pool) ---
+    DescentJob<Graph> job(g, config, seed, max_iter);
+    job.step(stop);
+    PoolDescentResult<Graph> P;
+    DescentResult<Graph>& D = P.descent;
+    D = std::move(job.result());
+
+    // Buscas depois da primeira falha: max_iter por busca (como as sondagens de probing.hpp);
+    // as lacunas da recombinação recebem uma busca curta
+    TabuConfig search = config;
+    search.max_iter = (int)std::min<long long>(max_iter, std::numeric_limits<int>::max());
+    TabuConfig gap = config;
+    gap.max_iter = std::min(search.max_iter, std::max(1000, 10 * config.perturbation_limit));
+
+    auto record = [&](int k, const TabuResult& R) {
+        D.total_iterations += R.iterations;
+        D.profile.push_back({k, R.solved, R.iterations, R.final_obj, R.search_seconds});
+    };
+    auto improve = [&](BasicSolutionManager<Graph>&& S) {
+        D.best = std::move(S);
+        D.best_k = D.best.k;
+        if (config.metrics) config.metrics->best_k.store(D.best_k, std::memory_order_relaxed);
+    };
+
+    bool base_ok = rounds > 0 && !D.profile.empty() && D.profile.front().solved;
+    while (base_ok && !stop.is_time_up() && D.best_k > 1) {
+        // --- RECOMBINAÇÃO em best_k - 1 ---
+        const int target = D.best_k - 1;
+        const int f = g.n / target;
+        bool closed = false;
+        for (int r = 0; r < rounds && !closed && !stop.is_time_up(); ++r) {
+            int round_seed = seed + 7919 * target + 104729 * (r + 1);
+            auto C = pool.snapshot(f, g.n % target ? f + 1 : f);
+            std::mt19937 rng(round_seed);
+            SetPartition SP(C, g.n, target, rng);
+            auto part = SP.solve(node_limit, stop);
+            P.partitions++;
+            if (part.exact) P.exact++;
+
+            auto S = assemble_from_classes(g, target, C, part.chosen, round_seed);
+            auto R = S.run_tabu_search(gap, stop, round_seed);
+            record(target, R);
+            if (R.solved) {
+                improve(std::move(S));
+                P.closed++;
+                closed = true;
+            }
+        }
+        if (!closed) break;
+
+        // --- DESCIDA PADRÃO a partir da nova base ---
+        while (!stop.is_time_up() && D.best_k > 1) {
+            BasicSolutionManager<Graph> next(g, D.best_k - 1);
+            next.construct_greedy_from_previous(D.best, seed);
+            auto R = next.run_tabu_search(search, stop, seed);
+            record(next.k, R);
+            if (!R.solved) break;
+            improve(std::move(next));
+        }
+    }
+    P.pool_classes = pool.size();
+    return P;
+}
+
+} // namespace tabueqcol
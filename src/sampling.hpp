@@ -0,0 +1,275 @@
+// sampling.hpp
+// C++17 header-only: extração de subgrafos representativos (proxies) para calibração rápida
+//
+// Métodos:
+//   - induced:     subconjunto uniforme de vértices + subgrafo induzido
+//   - forest_fire: queimada (Leskovec & Faloutsos, 2006) + subgrafo induzido
+// Ambos aceitam correção de densidade: o proxy é ajustado para ter a mesma densidade
+// de arestas 2m / (n(n-1)) da instância completa (é a densidade, e não o grau médio,
+// que determina o comportamento do k nas instâncias aleatórias/planted).
+//
+// Usage example (sketch):
+//   auto P = tabueqcol::sample_forest_fire(inst, 500, 0.7, seed);
+//   tabueqcol::correct_density(P, graph_stats(inst).density, seed);
+//   auto cmp = tabueqcol::compare_stats(graph_stats(inst), graph_stats(P));
+//
+
+#pragma once
+#include <vector>
+#include <random>
+#include <algorithm>
+#include <numeric>
+#include <cmath>
+#include <deque>
+#include <unordered_set>
+#include <stdexcept>
+#include "tabu_search.hpp"
+#include "parallel.hpp"
+
+namespace tabueqcol {
+
+struct GraphStats {
+    int n = 0;
+    long long m = 0;
+    double density = 0.0;     // 2m / (n(n-1))
+    double avg_degree = 0.0;
+    double degree_cv = 0.0;   // desvio padrão / média dos graus
+    double clustering = 0.0;  // coeficiente de agrupamento local médio
+    std::vector<double> rel_degree; // grau / (n-1), ordenado (para o KS)
+};
+
+// Agrupamento local de v: triângulos por interseção de listas ordenadas do CSR
+inline double local_clustering(const Instance& I, int v) {
+    auto Nv = I.adj[v];
+    int d = Nv.size();
+    if (d < 2) return 0.0;
+    long long tri = 0;
+    for (int u : Nv) {
+        auto Nu = I.adj[u];
+        const int *a = Nv.begin(), *ae = Nv.end(), *b = Nu.begin(), *be = Nu.end();
+        while (a != ae && b != be) {
+            if (*a < *b) ++a;
+            else if (*b < *a) ++b;
+            else { ++tri; ++a; ++b; }
+        }
+    }
+    // cada triângulo em v é contado duas vezes (pelos dois vizinhos)
+    return (double)tri / ((double)d * (d - 1));
+}
+
+// clustering_samples <= 0 calcula o agrupamento exato; caso contrário estima com uma amostra de vértices
+inline GraphStats graph_stats(const Instance& I, int clustering_samples = 0, int seed = 0) {
+    GraphStats s;
+    s.n = I.n;
+    s.m = I.m;
+    if (I.n <= 1) return s;
+
+    s.density = 2.0 * I.m / ((double)I.n * (I.n - 1));
+    s.avg_degree = 2.0 * I.m / I.n;
+
+    double var = 0.0;
+    s.rel_degree.resize(I.n);
+    for (int v = 0; v < I.n; ++v) {
+        double d = I.degree(v);
+        var += (d - s.avg_degree) * (d - s.avg_degree);
+        s.rel_degree[v] = d / (I.n - 1);
+    }
+    var /= I.n;
+    s.degree_cv = s.avg_degree > 0 ? std::sqrt(var) / s.avg_degree : 0.0;
+    std::sort(s.rel_degree.begin(), s.rel_degree.end());
+
+    std::vector<int> pick;
+    if (clustering_samples > 0 && clustering_samples < I.n) {
+        std::mt19937 rng(seed);
+        std::uniform_int_distribution<int> d_n(0, I.n - 1);
+        pick.resize(clustering_samples);
+        for (int &v : pick) v = d_n(rng);
+    } else {
+        pick.resize(I.n);
+        std::iota(pick.begin(), pick.end(), 0);
+    }
+
+    std::vector<double> part(default_thread_count(), 0.0);
+    parallel_for(0, (long long)pick.size(), [&](long long lo, long long hi, int tid) {
+        double acc = 0.0;
+        for (long long i = lo; i < hi; ++i) acc += local_clustering(I, pick[i]);
+        part[tid] += acc;
+    }, (int)part.size(), 256);
+    s.clustering = std::accumulate(part.begin(), part.end(), 0.0) / pick.size();
+
+    return s;
+}
+
+// Distância de Kolmogorov-Smirnov entre duas amostras ordenadas
+inline double ks_distance(const std::vector<double>& a, const std::vector<double>& b) {
+    if (a.empty() || b.empty()) return 1.0;
+    size_t i = 0, j = 0;
+    double best = 0.0;
+    while (i < a.size() && j < b.size()) {
+        double x = std::min(a[i], b[j]);
+        while (i < a.size() && a[i] <= x) ++i;
+        while (j < b.size() && b[j] <= x) ++j;
+        best = std::max(best, std::fabs((double)i / a.size() - (double)j / b.size()));
+    }
+    return best;
+}
+
+struct ProxyFidelity {
+    double ks_rel_degree = 0.0;   // KS entre distribuições de grau relativo
+    double density_ratio = 0.0;   // densidade proxy / completa
+    double cv_ratio = 0.0;        // CV dos graus proxy / completa
+    double clustering_ratio = 0.0;// agrupamento proxy / completa
+    double score = 0.0;           // 1 = idêntico; 0 = sem relação
+};
+
+inline ProxyFidelity compare_stats(const GraphStats& full, const GraphStats& proxy) {
+    auto ratio = [](double a, double b) { return b > 0 ? a / b : (a > 0 ? 0.0 : 1.0); };
+    auto closeness = [](double r) { return r > 0 ? std::min(r, 1.0 / r) : 0.0; };
+
+    ProxyFidelity f;
+    f.ks_rel_degree = ks_distance(full.rel_degree, proxy.rel_degree);
+    f.density_ratio = ratio(proxy.density, full.density);
+    f.cv_ratio = ratio(proxy.degree_cv, full.degree_cv);
+    f.clustering_ratio = ratio(proxy.clustering, full.clustering);
+    f.score = (1.0 - f.ks_rel_degree) * closeness(f.density_ratio) * closeness(f.cv_ratio) * closeness(f.clustering_ratio);
+    return f;
+}
+
+// Subgrafo induzido por 'keep' (vértices renumerados na ordem de 'keep')
+inline Instance induced_subgraph(const Instance& I, const std::vector<int>& keep) {
+    std::vector<int> new_id(I.n, -1);
+    for (int i = 0; i < (int)keep.size(); ++i) new_id[keep[i]] = i;
+
+    Instance P;
+    P.n = (int)keep.size();
+    for (int i = 0; i < P.n; ++i) {
+        for (int u : I.adj[keep[i]]) {
+            int j = new_id[u];
+            if (j > i) P.edges.emplace_back(i, j);
+        }
+    }
+    P.build_adj();
+    return P;
+}
+
+inline Instance sample_induced(const Instance& I, int target_n, int seed = 0) {
+    std::mt19937 rng(seed);
+    std::vector<int> all(I.n);
+    std::iota(all.begin(), all.end(), 0);
+    std::shuffle(all.begin(), all.end(), rng);
+    all.resize(std::min(target_n, I.n));
+    std::sort(all.begin(), all.end());
+    return induced_subgraph(I, all);
+}
+
+// Forest fire: a partir de sementes aleatórias, cada vértice queimado "incendeia" um número
+// geométrico (média pf / (1 - pf)) de vizinhos ainda não visitados; pf em (0, 1)
+inline Instance sample_forest_fire(const Instance& I, int target_n, double pf = 0.7, int seed = 0) {
+    if (!(pf > 0.0 && pf < 1.0)) throw std::runtime_error("Forest fire burn probability must be in (0, 1)");
+    target_n = std::min(target_n, I.n);
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> d_n(0, I.n - 1);
+    std::geometric_distribution<int> burn(1.0 - pf);
+
+    std::vector<char> burned(I.n, 0);
+    std::vector<int> keep;
+    keep.reserve(target_n);
+    std::deque<int> frontier;
+    std::vector<int> cand;
+
+    while ((int)keep.size() < target_n) {
+        if (frontier.empty()) {
+            // Nova ignição (fogo extinto ou componente esgotada)
+            int s = d_n(rng);
+            if (burned[s]) continue;
+            burned[s] = 1;
+            keep.push_back(s);
+            frontier.push_back(s);
+            continue;
+        }
+        int v = frontier.front();
+        frontier.pop_front();
+
+        cand.clear();
+        for (int u : I.adj[v]) if (!burned[u]) cand.push_back(u);
+        std::shuffle(cand.begin(), cand.end(), rng);
+        int x = std::min<int>(burn(rng), (int)cand.size());
+        for (int i = 0; i < x && (int)keep.size() < target_n; ++i) {
+            burned[cand[i]] = 1;
+            keep.push_back(cand[i]);
+            frontier.push_back(cand[i]);
+        }
+    }
+
+    std::sort(keep.begin(), keep.end());
+    return induced_subgraph(I, keep);
+}
+
+// Ajusta a densidade do proxy para 'target_density'.
+// Excesso: remove as arestas menos "embutidas" (menos triângulos). Falta: fecha triângulos (preserva o agrupamento);
+// quando não há mais cunhas abertas úteis, completa com pares aleatórios.
+inline void correct_density(Instance& P, double target_density, int seed = 0) {
+    if (P.n < 2) return;
+    std::mt19937_64 rng(seed);
+    long long target_m = (long long)std::llround(target_density * (double)P.n * (P.n - 1) / 2.0);
+
+    std::vector<std::pair<int,int>> E;
+    E.reserve(std::max(P.m, target_m));
+    for (int v = 0; v < P.n; ++v)
+        for (int u : P.adj[v]) if (u > v) E.emplace_back(v, u);
+
+    if ((long long)E.size() > target_m) {
+        // Remove primeiro as arestas que participam de menos triângulos (preserva o agrupamento)
+        std::vector<std::pair<int, unsigned long long>> order(E.size());
+        for (size_t i = 0; i < E.size(); ++i) {
+            auto Na = P.adj[E[i].first], Nb = P.adj[E[i].second];
+            int tri = 0;
+            const int *a = Na.begin(), *b = Nb.begin();
+            while (a != Na.end() && b != Nb.end()) {
+                if (*a < *b) ++a;
+                else if (*b < *a) ++b;
+                else { ++tri; ++a; ++b; }
+            }
+            order[i] = { -tri, rng() }; // desempate aleatório
+        }
+        std::vector<size_t> idx(E.size());
+        std::iota(idx.begin(), idx.end(), 0);
+        std::sort(idx.begin(), idx.end(), [&](size_t x, size_t y) { return order[x] < order[y]; });
+
+        std::vector<std::pair<int,int>> kept;
+        kept.reserve(target_m);
+        for (long long i = 0; i < target_m; ++i) kept.push_back(E[idx[i]]);
+        E.swap(kept);
+    } else if ((long long)E.size() < target_m) {
+        auto key = [](int a, int b) { if (a > b) std::swap(a, b); return ((unsigned long long)a << 32) | (unsigned)b; };
+        std::unordered_set<unsigned long long> present;
+        present.reserve(target_m * 2);
+        for (auto &e : E) present.insert(key(e.first, e.second));
+
+        std::uniform_int_distribution<int> d_n(0, P.n - 1);
+        long long missing = target_m - (long long)E.size();
+        long long misses = 0;
+        while (missing > 0) {
+            int a, b;
+            int w = d_n(rng);
+            if (misses < 64 && P.adj[w].size() >= 2) {
+                auto Nw = P.adj[w];
+                std::uniform_int_distribution<int> d_w(0, Nw.size() - 1);
+                a = Nw.begin()[d_w(rng)];
+                b = Nw.begin()[d_w(rng)];
+            } else {
+                a = w;
+                b = d_n(rng);
+            }
+            if (a == b || !present.insert(key(a, b)).second) { misses++; continue; }
+            E.emplace_back(a, b);
+            missing--;
+            misses = 0;
+        }
+    }
+
+    P.edges = std::move(E);
+    P.build_adj();
+}
+
+} // namespace tabueqcol
@@ -0,0 +1,179 @@
+// scheduler.hpp
+// C++17 header-only: escalonador em fatias para muitos jobs pequenos (modo lote)
+//
+// Usage example (sketch):
+//   BatchOptions opt;                     // fatia de 256 iterações, 4 jobs ativos por worker
+//   run_batch<Instance>(paths.size(),
+//       [&](int i) { return read_instance(paths[i]); },   // carrega o job i (na thread do worker)
+//       config, seed, max_iter, opt,
+//       [&](BatchJobReport<Instance>& r) { ... });        // chamado pelo worker ao terminar o job
+//
+// Cada worker mantém até 'max_active' descidas e as executa em rodízio, 'slice_iters'
+// iterações por vez: um job curto termina em poucas fatias mesmo atrás de jobs longos,
+// e nenhum job espera mais que (max_active - 1) fatias entre duas execuções suas.
+// Criar uma thread (ou processo) por job custaria mais que a própria busca.
+//
+// Grafos com n <= TINY_N não viram DescentJob: vão para as pistas do bloco em lockstep do
+// worker (tiny_batch.hpp), que ocupa uma única posição no rodízio. Pistas que terminam
+// são reocupadas pelos próximos grafos pequenos já admitidos.
+
+#pragma once
+#include "descent.hpp"
+#include "tiny_batch.hpp"
+#include <deque>
+#include <string>
+#include <exception>
+
+namespace tabueqcol {
+
+struct BatchOptions {
+    long long slice_iters = 256;  // iterações de tabu por fatia
+    int workers = 1;              // threads; <= 0 usa default_thread_count()
+    int max_active = 4;           // jobs intercalados por worker
+    double time_limit = 1000.0;   // limite por job (segundos), contado da admissão
+    int tiny = 1;                 // 1 = grafos com n <= TINY_N vão para o bloco em lockstep
+};
+
+template <class Graph>
+struct BatchJobReport {
+    int index = -1;
+    std::string error;            // vazio = ok (ex: falha ao ler a instância)
+    double latency_seconds = 0.0; // admissão -> fim
+    long long slices = 0;         // fatias executadas
+    bool tiny = false;            // resolvido no bloco em lockstep (tiny_batch.hpp)
+    DescentResult<Graph> descent;
+};
+
+// Resolve os jobs 0..num_jobs-1. 'load(i)' devolve o grafo do job i; 'done(report)' é
+// chamado da thread do worker (o chamador sincroniza o que for compartilhado); o grafo
+// de report.descent.best só é válido durante a chamada.
+template <class Graph, class Load, class Done>
+void run_batch(int num_jobs, Load&& load, const TabuConfig& config, int seed, long long max_iter,
+               const BatchOptions& opt, Done&& done) {
+    if (num_jobs <= 0) return;
+    int workers = opt.workers > 0 ? opt.workers : default_thread_count();
+    workers = std::min(workers, num_jobs);
+    const long long slice = std::max(1LL, opt.slice_iters);
+    const int max_active = std::max(1, opt.max_active);
+
+    // Job em execução: o grafo pertence a ele (DescentJob guarda só um ponteiro).
+    // job == nullptr marca a posição do bloco de grafos pequenos no rodízio.
+    struct Active {
+        int index;
+        std::unique_ptr<Graph> graph;
+        std::unique_ptr<DescentJob<Graph>> job;
+        StopCriterion stop;
+        long long slices = 0;
+    };
+
+    std::atomic<int> next(0);
+    SolverMetrics* M = config.metrics;
+    if (M) M->jobs_queued.fetch_add(num_jobs, std::memory_order_relaxed);
+
+    auto finish_job = [&](BatchJobReport<Graph>& r) {
+        if (M) {
+            M->jobs_active.fetch_sub(1, std::memory_order_relaxed);
+            M->jobs_done.fetch_add(1, std::memory_order_relaxed);
+        }
+        done(r);
+    };
+
+    parallel_for(0, workers, [&](long long, long long, int) {
+        std::deque<Active> ring;
+        bool drained = false;
+
+        // Grafos pequenos: admitidos esperando pista, e os que ocupam as pistas do bloco
+        std::deque<Active> tiny_wait;
+        std::unique_ptr<Active> lanes[TINY_LANES];
+        std::unique_ptr<TinyBatch> block;
+        bool block_in_ring = false;
+
+        while (true) {
+            // Admite jobs novos até encher a janela (e a fila de pistas)
+            while (!drained && (int)ring.size() - (int)block_in_ring < max_active &&
+                   (int)tiny_wait.size() < TINY_LANES) {
+                int i = next.fetch_add(1, std::memory_order_relaxed);
+                if (i >= num_jobs) {
+                    drained = true;
+                    break;
+                }
+                StopCriterion stop(opt.time_limit);
+                if (M) {
+                    M->jobs_queued.fetch_sub(1, std::memory_order_relaxed);
+                    M->jobs_active.fetch_add(1, std::memory_order_relaxed);
+                }
+                try {
+                    auto g = std::make_unique<Graph>(load(i));
+                    if (opt.tiny && fits_tiny(*g)) {
+                        tiny_wait.push_back(Active{i, std::move(g), nullptr, stop, 0});
+                        if (!block_in_ring) {
+                            ring.push_back(Active{-1, nullptr, nullptr, stop, 0});
+                            block_in_ring = true;
+                        }
+                    } else {
+                        auto job = std::make_unique<DescentJob<Graph>>(*g, config, seed, max_iter);
+                        ring.push_back(Active{i, std::move(g), std::move(job), stop, 0});
+                    }
+                } catch (const std::exception& e) {
+                    BatchJobReport<Graph> r;
+                    r.index = i;
+                    r.error = e.what();
+                    r.latency_seconds = stop.get_elapsed();
+                    finish_job(r);
+                }
+            }
+            if (ring.empty()) break;
+
+            // Rodízio: uma fatia para o job da frente, que volta para o fim da fila
+            Active a = std::move(ring.front());
+            ring.pop_front();
+
+            if (!a.job) {
+                // Bloco em lockstep: ocupa as pistas livres, uma fatia, entrega quem terminou
+                if (!block) block.reset(new TinyBatch(config, max_iter));
+                for (int l; !tiny_wait.empty() && (l = block->free_lane()) != -1;) {
+                    lanes[l].reset(new Active(std::move(tiny_wait.front())));
+                    tiny_wait.pop_front();
+                    block->load(l, *lanes[l]->graph, seed, &lanes[l]->stop);
+                }
+                block->step(slice);
+                for (int l = 0; l < TINY_LANES; ++l) {
+                    if (!lanes[l]) continue;
+                    lanes[l]->slices++;
+                    if (!block->finished(l)) continue;
+                    BatchJobReport<Graph> r;
+                    r.index = lanes[l]->index;
+                    r.latency_seconds = lanes[l]->stop.get_elapsed();
+                    r.slices = lanes[l]->slices;
+                    r.tiny = true;
+                    r.descent.initial_k = block->lane_initial_k(l);
+                    r.descent.best_k = block->lane_best_k(l);
+                    r.descent.total_iterations = block->lane_iterations(l);
+                    r.descent.best = BasicSolutionManager<Graph>(*lanes[l]->graph, r.descent.best_k);
+                    r.descent.best.compute_from_coloring(block->lane_best_color(l));
+                    if (M) M->iterations.fetch_add(r.descent.total_iterations, std::memory_order_relaxed);
+                    block->release(l);
+                    finish_job(r);
+                    lanes[l].reset();
+                }
+                if (block->empty() && tiny_wait.empty()) block_in_ring = false;
+                else ring.push_back(std::move(a));
+                continue;
+            }
+
+            a.slices++;
+            if (a.job->step(a.stop, slice)) {
+                BatchJobReport<Graph> r;
+                r.index = a.index;
+                r.latency_seconds = a.stop.get_elapsed();
+                r.slices = a.slices;
+                r.descent = std::move(a.job->result());
+                finish_job(r);
+            } else {
+                ring.push_back(std::move(a));
+            }
+        }
+    }, workers, 1);
+}
+
+} // namespace tabueqcol
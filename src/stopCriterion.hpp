@@ -1,18 +1,58 @@
 #pragma once
+#include <algorithm>
+#include <atomic>
 #include <chrono>
+#include <memory>
+#include <thread>
+#include "portable.hpp"
+
+// Orçamentos de parada. O limite de parede (max_time_seconds) vale sempre, como teto de
+// segurança; os demais são um segundo limite, na unidade própria:
+//   BUDGET_WALL         só o tempo de parede
+//   BUDGET_PROCESS_CPU  segundos de CPU do processo (todas as threads, inclusive o pool)
+//   BUDGET_THREAD_CPU   segundos de CPU da thread que consulta (desde a construção, na
+//                       thread que construiu; desde o início da thread, nas outras)
+//   BUDGET_WORK         unidades de trabalho: entradas de adjacência percorridas ao aplicar
+//                       movimentos + vértices de C(s) avaliados por iteração, lançadas pelo
+//                       laço tabu (add_work). Com a mesma semente e uma trajetória que não
+//                       depende do relógio (--autotune 0, sem portfólio nem adaptação das
+//                       amostras) a execução é idêntica em qualquer máquina. Buscas que rodam
+//                       ao mesmo tempo precisam de concurrent_share() (componentes.hpp); o
+//                       portfólio e a sondagem (--probe_depth) lançam no mesmo contador de
+//                       várias threads e o lote só usa o tempo de parede, então esses modos
+//                       não são determinísticos com BUDGET_WORK
+enum StopBudget { BUDGET_WALL = 0, BUDGET_PROCESS_CPU = 1, BUDGET_THREAD_CPU = 2, BUDGET_WORK = 3 };
 
 struct StopCriterion {
     std::chrono::high_resolution_clock::time_point start_time;
     double max_time_seconds;
-    
-    StopCriterion(double time_limit) 
-        : start_time(std::chrono::high_resolution_clock::now()), 
-          max_time_seconds(time_limit) {}
+
+    int budget = BUDGET_WALL;
+    double budget_limit = 0.0; // na unidade do orçamento (segundos de CPU ou unidades de trabalho)
+    double process_cpu0 = 0.0;
+    double thread_cpu0 = 0.0;
+    std::thread::id owner;
+    // Contador de trabalho compartilhado pelas cópias (jobs, componentes, sondagens)
+    std::shared_ptr<std::atomic<long long>> work;
+
+    StopCriterion(double time_limit)
+        : start_time(std::chrono::high_resolution_clock::now()),
+          max_time_seconds(time_limit),
+          work(std::make_shared<std::atomic<long long>>(0)) {}
+
+    StopCriterion(double time_limit, int budget, double limit) : StopCriterion(time_limit) {
+        this->budget = budget;
+        budget_limit = limit;
+        process_cpu0 = tabueqcol::process_cpu_seconds();
+        thread_cpu0 = tabueqcol::thread_cpu_seconds();
+        owner = std::this_thread::get_id();
+    }
 
     bool is_time_up() const {
         auto now = std::chrono::high_resolution_clock::now();
         std::chrono::duration<double> elapsed = now - start_time;
-        return elapsed.count() >= max_time_seconds;
+        if (elapsed.count() >= max_time_seconds) return true;
+        return budget != BUDGET_WALL && get_used() >= budget_limit;
     }
 
     double get_elapsed() const {
@@ -20,4 +60,52 @@ struct StopCriterion {
         std::chrono::duration<double> elapsed = now - start_time;
         return elapsed.count();
     }
-};
\ No newline at end of file
+
+    // Consumo na unidade do orçamento (segundos de parede em BUDGET_WALL)
+    double get_used() const {
+        switch (budget) {
+            case BUDGET_PROCESS_CPU:
+                return tabueqcol::process_cpu_seconds() - process_cpu0;
+            case BUDGET_THREAD_CPU:
+                return tabueqcol::thread_cpu_seconds() -
+                       (std::this_thread::get_id() == owner ? thread_cpu0 : 0.0);
+            case BUDGET_WORK:
+                return (double)work->load(std::memory_order_relaxed);
+            default:
+                return get_elapsed();
+        }
+    }
+
+    long long get_work() const { return work->load(std::memory_order_relaxed); }
+
+    void add_work(long long units) const { work->fetch_add(units, std::memory_order_relaxed); }
+
+    // Sub-orçamento com 'fraction' do que resta (mesmo relógio, mesmo contador de trabalho)
+    StopCriterion fraction_of_remaining(double fraction) const {
+        StopCriterion S = *this;
+        double elapsed = get_elapsed();
+        S.max_time_seconds = elapsed + fraction * std::max(0.0, max_time_seconds - elapsed);
+        if (budget != BUDGET_WALL) {
+            double used = get_used();
+            S.budget_limit = used + fraction * std::max(0.0, budget_limit - used);
+        }
+        return S;
+    }
+
+    // Sub-orçamento de uma entre várias buscas simultâneas: relógio e CPU como em
+    // fraction_of_remaining(fraction), mas o trabalho ganha contador próprio com 'share' do
+    // trabalho desse sub-orçamento, então o ponto de parada não depende do entrelaçamento
+    // das threads. Depois de juntá-las, quem dividiu lança o consumo com absorb().
+    StopCriterion concurrent_share(double fraction, double share) const {
+        StopCriterion S = fraction_of_remaining(fraction);
+        if (budget == BUDGET_WORK) {
+            S.budget_limit = share * std::max(0.0, S.budget_limit - get_used());
+            S.work = std::make_shared<std::atomic<long long>>(0);
+        }
+        return S;
+    }
+
+    void absorb(const StopCriterion& share) const {
+        if (share.work != work) add_work(share.get_work());
+    }
+};
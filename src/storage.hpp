@@ -0,0 +1,198 @@
+// storage.hpp
+// C++17 header-only: representações da adjacência e o despacho único para elas
+//
+// Usage example (sketch):
+//   return tabueqcol::with_storage(inst, tabueqcol::STORAGE_COMPLEMENT, [&](const auto& G) {
+//       return run(G);                  // instanciado uma vez por representação
+//   });
+//
+// Todas seguem o conceito de grafo de tabu_search.hpp, então cada uma gera a sua própria
+// instanciação de BasicSolutionManager<G> (construções, varreduras, laço tabu inteiro)
+// sem indireção por vizinho: o for_each_neighbour de cada tipo é resolvido e expandido em
+// tempo de compilação. A escolha em tempo de execução acontece uma vez, em with_storage():
+//   csr         Instance (CSR ordenado, busca binária em adjacent)
+//   lists       vetor de vetores (uma alocação por linha; útil quando o grafo vai crescer)
+//   bitset      matriz de bits n x n (bitset_graph.hpp): adjacent em O(1)
+//   complement  CSR do complemento: grafos com densidade > 1/2 guardam menos da metade
+//   compressed  gaps em stream-VByte (compressed_graph.hpp)
+// with_storage aceita a instância só com a lista de arestas (read_instance(path, false)):
+// compressed codifica direto das linhas ordenadas da construção, sem o CSR compacto; as
+// demais são montadas a partir do CSR, que é liberado antes da busca (exceto em csr, claro).
+
+#pragma once
+#include <vector>
+#include <string>
+#include <algorithm>
+#include "tabu_search.hpp"
+#include "bitset_graph.hpp"
+#include "compressed_graph.hpp"
+#include "parallel.hpp"
+
+namespace tabueqcol {
+
+enum Storage { STORAGE_CSR = 0, STORAGE_COMPRESSED = 1, STORAGE_LISTS = 2, STORAGE_BITSET = 3, STORAGE_COMPLEMENT = 4 };
+
+inline const char* storage_name(int s) {
+    switch (s) {
+        case STORAGE_COMPRESSED: return "compressed";
+        case STORAGE_LISTS: return "lists";
+        case STORAGE_BITSET: return "bitset";
+        case STORAGE_COMPLEMENT: return "complement";
+        default: return "csr";
+    }
+}
+
+// ------------------ Vetor de vetores ------------------
+struct ListGraph {
+    int n = 0;
+    int max_degree = 0;
+    std::vector<std::vector<int>> rows; // vizinhos ordenados
+
+    ListGraph() = default;
+
+    explicit ListGraph(const Instance& I, int threads = 0) : n(I.n), max_degree(I.max_degree), rows(I.n) {
+        parallel_for(0, n, [&](long long lo, long long hi, int) {
+            for (long long v = lo; v < hi; ++v) {
+                auto r = I.adj[(int)v];
+                rows[v].assign(r.begin(), r.end());
+            }
+        }, threads);
+    }
+
+    int degree(int v) const { return (int)rows[v].size(); }
+
+    template <class F>
+    void for_each_neighbour(int v, F&& f) const {
+        for (int u : rows[v]) {
+            if (!visit_neighbour(f, u)) return;
+        }
+    }
+
+    bool adjacent(int u, int v) const {
+        const auto& r = rows[u];
+        return std::binary_search(r.begin(), r.end(), v);
+    }
+
+    void memory_report(MemoryReport& R) const {
+        long long bytes = vector_bytes(rows);
+        for (const auto& r : rows) bytes += vector_bytes(r);
+        R.add("lists.rows", bytes);
+    }
+};
+
+// ------------------ Complemento ------------------
+// Guarda os não vizinhos de cada v (sem o próprio v). A enumeração percorre 0..n-1 pulando
+// a linha do complemento (intercalação de duas sequências ordenadas): O(n) por vértice, o
+// mesmo que O(grau) quando o grafo é denso.
+struct ComplementGraph {
+    int n = 0;
+    long long m = 0;
+    int max_degree = 0;
+    std::vector<long long> offset; // n + 1 entradas
+    std::vector<int> missing;      // não vizinhos ordenados
+    std::vector<int> degrees;
+
+    ComplementGraph() = default;
+
+    explicit ComplementGraph(const Instance& I, int threads = 0)
+        : n(I.n), m(I.m), max_degree(I.max_degree), degrees(I.degrees) {
+        offset.assign(n + 1, 0);
+        parallel_for(0, n, [&](long long lo, long long hi, int) {
+            for (long long v = lo; v < hi; ++v) offset[v] = (long long)n - 1 - degrees[v];
+        }, threads);
+        parallel_exclusive_scan(offset, threads);
+
+        missing.resize(offset[n]);
+        parallel_for(0, n, [&](long long lo, long long hi, int) {
+            for (long long v = lo; v < hi; ++v) {
+                int* out = missing.data() + offset[v];
+                auto r = I.adj[(int)v];
+                const int* a = r.begin();
+                for (int u = 0; u < n; ++u) {
+                    if (a != r.end() && *a == u) { ++a; continue; }
+                    if (u != (int)v) *out++ = u;
+                }
+            }
+        }, threads, 1 << 8);
+    }
+
+    // Bytes do complemento para n vértices e m arestas (para decidir antes de construir)
+    static long long bytes_for(long long n, long long m) {
+        return (n + 1) * (long long)sizeof(long long) + (n * (n - 1) - 2 * m) * (long long)sizeof(int);
+    }
+
+    int degree(int v) const { return degrees[v]; }
+
+    template <class F>
+    void for_each_neighbour(int v, F&& f) const {
+        const int* a = missing.data() + offset[v];
+        const int* end = missing.data() + offset[v + 1];
+        int u = 0;
+        for (;;) {
+            // Próximo buraco: o próximo não vizinho ou o próprio v (que não está na linha)
+            int hole = a != end ? *a : n;
+            if (v >= u && v < hole) hole = v;
+            else if (hole < n) ++a;
+            for (; u < hole; ++u) {
+                if (!visit_neighbour(f, u)) return;
+            }
+            if (hole == n) return;
+            u = hole + 1;
+        }
+    }
+
+    bool adjacent(int u, int v) const {
+        if (u == v) return false;
+        const int* a = missing.data() + offset[u];
+        return !std::binary_search(a, missing.data() + offset[u + 1], v);
+    }
+
+    void memory_report(MemoryReport& R) const {
+        R.add("complement.offset", vector_bytes(offset));
+        R.add("complement.missing", vector_bytes(missing));
+        R.add("complement.degrees", vector_bytes(degrees));
+    }
+};
+
+// ------------------ Despacho ------------------
+// Monta a representação 's' a partir de 'inst' (CSR pronto ou só a lista de arestas),
+// libera o CSR (se não for ele o escolhido) e chama f(G) com o tipo concreto. f é genérico
+// (auto): uma instanciação por tipo. inst.n e inst.m continuam valendo para relatórios.
+template <class F>
+inline auto with_storage(Instance& inst, int s, F&& f) {
+    const bool built = !inst.adj.offset.empty();
+    if (!built && s != STORAGE_COMPRESSED) inst.build_adj();
+    auto release = [&]() {
+        int n = inst.n;
+        long long m = inst.m;
+        inst = Instance();
+        inst.n = n;
+        inst.m = m;
+    };
+    switch (s) {
+        case STORAGE_COMPRESSED: {
+            CompressedGraph G = built ? CompressedGraph(inst) : CompressedGraph::from_edges(inst);
+            release();
+            return f(G);
+        }
+        case STORAGE_LISTS: {
+            ListGraph G(inst);
+            release();
+            return f(G);
+        }
+        case STORAGE_BITSET: {
+            BitsetGraph G(inst);
+            release();
+            return f(G);
+        }
+        case STORAGE_COMPLEMENT: {
+            ComplementGraph G(inst);
+            release();
+            return f(G);
+        }
+        default:
+            return f(static_cast<const Instance&>(inst));
+    }
+}
+
+} // namespace tabueqcol
@@ -0,0 +1,282 @@
+// stream_input.hpp
+// C++17 header-only: leitura em fluxo de arquivos de instância (texto puro, gzip ou zstd)
+//
+// Usage example (sketch):
+//   TokenStream in(path);                 // o formato vem dos bytes mágicos, não da extensão
+//   long long x;
+//   while (in.next(x)) ...                // inteiros separados por espaços/quebras de linha
+//
+// Uma thread produtora lê (e descomprime) blocos de 'block' bytes num anel de 'blocks'
+// buffers; a thread que chama next() converte os dígitos de um bloco enquanto os próximos
+// são preenchidos, então descompressão e parsing se sobrepõem e nada vai para o disco.
+// O parser é um laço de dígitos sobre o buffer (sem iostream); um número partido entre dois
+// blocos continua no bloco seguinte.
+//
+// zlib e zstd são opcionais: o CMake define TABU_ECP_HAVE_ZLIB / TABU_ECP_HAVE_ZSTD quando
+// encontra as bibliotecas. Sem elas, um arquivo comprimido é recusado com erro explícito.
+
+#pragma once
+#include <algorithm>
+#include <condition_variable>
+#include <cstdio>
+#include <cstring>
+#include <exception>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+#ifdef TABU_ECP_HAVE_ZLIB
+#include <zlib.h>
+#endif
+#ifdef TABU_ECP_HAVE_ZSTD
+#include <zstd.h>
+#endif
+
+namespace tabueqcol {
+
+enum InputFormat { INPUT_PLAIN = 0, INPUT_GZIP = 1, INPUT_ZSTD = 2 };
+
+inline const char* input_format_name(int f) {
+    switch (f) {
+        case INPUT_GZIP: return "gzip";
+        case INPUT_ZSTD: return "zstd";
+        default: return "texto";
+    }
+}
+
+// Fonte de bytes já descomprimidos. read() devolve 0 no fim do arquivo.
+class InputDecoder {
+public:
+    explicit InputDecoder(const std::string& path) : path(path) {
+        file = fopen(path.c_str(), "rb");
+        if (!file) throw std::runtime_error("Cannot open instance file: " + path);
+        unsigned char magic[4] = {0, 0, 0, 0};
+        size_t got = fread(magic, 1, 4, file);
+        if (got >= 2 && magic[0] == 0x1f && magic[1] == 0x8b) format = INPUT_GZIP;
+        else if (got == 4 && magic[0] == 0x28 && magic[1] == 0xb5 && magic[2] == 0x2f && magic[3] == 0xfd) format = INPUT_ZSTD;
+        rewind(file);
+
+        if (format == INPUT_GZIP) {
+#ifdef TABU_ECP_HAVE_ZLIB
+            fclose(file);
+            file = nullptr;
+            gz = gzopen(path.c_str(), "rb");
+            if (!gz) throw std::runtime_error("Cannot open instance file: " + path);
+            gzbuffer(gz, 1 << 20);
+#else
+            fclose(file);
+            throw std::runtime_error("Instance file is gzip-compressed but tabu_ecp was built without zlib: " + path);
+#endif
+        } else if (format == INPUT_ZSTD) {
+#ifdef TABU_ECP_HAVE_ZSTD
+            zstd = ZSTD_createDCtx();
+            zin_buf.resize(ZSTD_DStreamInSize());
+#else
+            fclose(file);
+            throw std::runtime_error("Instance file is zstd-compressed but tabu_ecp was built without libzstd: " + path);
+#endif
+        }
+    }
+
+    ~InputDecoder() {
+        if (file) fclose(file);
+#ifdef TABU_ECP_HAVE_ZLIB
+        if (gz) gzclose(gz);
+#endif
+#ifdef TABU_ECP_HAVE_ZSTD
+        if (zstd) ZSTD_freeDCtx(zstd);
+#endif
+    }
+
+    InputDecoder(const InputDecoder&) = delete;
+    InputDecoder& operator=(const InputDecoder&) = delete;
+
+    int get_format() const { return format; }
+
+    size_t read(char* out, size_t cap) {
+        switch (format) {
+#ifdef TABU_ECP_HAVE_ZLIB
+            case INPUT_GZIP: {
+                int got = gzread(gz, out, (unsigned)std::min<size_t>(cap, 1u << 30));
+                if (got < 0) {
+                    int err = 0;
+                    throw std::runtime_error("gzip error in " + path + ": " + gzerror(gz, &err));
+                }
+                return (size_t)got;
+            }
+#endif
+#ifdef TABU_ECP_HAVE_ZSTD
+            case INPUT_ZSTD: {
+                ZSTD_outBuffer zout{out, cap, 0};
+                while (zout.pos < zout.size) {
+                    if (zin.pos == zin.size) {
+                        size_t got = fread(zin_buf.data(), 1, zin_buf.size(), file);
+                        if (got == 0) {
+                            // Fim do arquivo no meio de um frame: entrada truncada
+                            if (zstd_pending != 0) throw std::runtime_error("Truncated zstd stream: " + path);
+                            break;
+                        }
+                        zin = ZSTD_inBuffer{zin_buf.data(), got, 0};
+                    }
+                    size_t ret = ZSTD_decompressStream(zstd, &zout, &zin);
+                    if (ZSTD_isError(ret)) {
+                        throw std::runtime_error("zstd error in " + path + ": " + ZSTD_getErrorName(ret));
+                    }
+                    zstd_pending = ret;
+                }
+                return zout.pos;
+            }
+#endif
+            default: {
+                size_t got = fread(out, 1, cap, file);
+                if (got == 0 && ferror(file)) throw std::runtime_error("Read error in instance file: " + path);
+                return got;
+            }
+        }
+    }
+
+private:
+    std::string path;
+    FILE* file = nullptr;
+    int format = INPUT_PLAIN;
+#ifdef TABU_ECP_HAVE_ZLIB
+    gzFile gz = nullptr;
+#endif
+#ifdef TABU_ECP_HAVE_ZSTD
+    ZSTD_DCtx* zstd = nullptr;
+    std::vector<char> zin_buf;
+    ZSTD_inBuffer zin{nullptr, 0, 0};
+    size_t zstd_pending = 0; // != 0: o frame atual ainda não terminou
+#endif
+};
+
+// Inteiros do arquivo, com leitura/descompressão numa thread própria
+class TokenStream {
+public:
+    explicit TokenStream(const std::string& path, size_t block = 1 << 22, int blocks = 4)
+        : decoder(path), buffers(std::max(2, blocks), std::vector<char>(block)), lengths(buffers.size(), 0) {
+        producer = std::thread([this]() { produce(); });
+    }
+
+    ~TokenStream() {
+        {
+            std::lock_guard<std::mutex> lk(mu);
+            closing = true;
+        }
+        cv_free.notify_all();
+        producer.join();
+    }
+
+    TokenStream(const TokenStream&) = delete;
+    TokenStream& operator=(const TokenStream&) = delete;
+
+    int format() const { return decoder.get_format(); }
+
+    // Próximo inteiro; false no fim do arquivo
+    bool next(long long& x) {
+        long long v = 0;
+        bool in_number = false, negative = false;
+        for (;;) {
+            if (pos == len) {
+                if (!advance()) break;
+                continue;
+            }
+            const char* p = cur + pos;
+            const char* end = cur + len;
+            // Laço quente: dígitos contíguos dentro do bloco
+            while (p != end) {
+                unsigned d = (unsigned)(*p - '0');
+                if (d < 10) {
+                    v = v * 10 + d;
+                    in_number = true;
+                } else if (in_number) {
+                    pos = (size_t)(p + 1 - cur);
+                    x = negative ? -v : v;
+                    return true;
+                } else {
+                    negative = *p == '-';
+                }
+                ++p;
+            }
+            pos = len;
+        }
+        if (in_number) x = negative ? -v : v;
+        return in_number;
+    }
+
+private:
+    void produce() {
+        const size_t B = buffers.size();
+        try {
+            for (;;) {
+                size_t slot;
+                {
+                    std::unique_lock<std::mutex> lk(mu);
+                    cv_free.wait(lk, [&]() { return closing || produced - consumed < B; });
+                    if (closing) return;
+                    slot = produced % B;
+                }
+                size_t got = decoder.read(buffers[slot].data(), buffers[slot].size());
+                {
+                    std::lock_guard<std::mutex> lk(mu);
+                    lengths[slot] = got;
+                    produced++;
+                    if (got == 0) eof = true;
+                }
+                cv_filled.notify_one();
+                if (got == 0) return;
+            }
+        } catch (...) {
+            std::lock_guard<std::mutex> lk(mu);
+            error = std::current_exception();
+            eof = true;
+            cv_filled.notify_one();
+        }
+    }
+
+    // Devolve o bloco atual ao produtor e espera o próximo; false no fim do arquivo
+    bool advance() {
+        const size_t B = buffers.size();
+        std::unique_lock<std::mutex> lk(mu);
+        if (holding) {
+            consumed++;
+            holding = false;
+            cv_free.notify_one();
+        }
+        cv_filled.wait(lk, [&]() { return consumed < produced || (eof && consumed == produced); });
+        if (consumed == produced) {
+            if (error) std::rethrow_exception(error);
+            return false;
+        }
+        size_t slot = consumed % B;
+        if (lengths[slot] == 0) {
+            // Marcador de fim: o bloco vazio não é consumido
+            if (error) std::rethrow_exception(error);
+            return false;
+        }
+        cur = buffers[slot].data();
+        len = lengths[slot];
+        pos = 0;
+        holding = true;
+        return true;
+    }
+
+    InputDecoder decoder;
+    std::vector<std::vector<char>> buffers;
+    std::vector<size_t> lengths;
+    std::thread producer;
+
+    std::mutex mu;
+    std::condition_variable cv_free, cv_filled;
+    size_t produced = 0, consumed = 0; // blocos preenchidos / devolvidos
+    bool eof = false, closing = false;
+    std::exception_ptr error;
+
+    // Bloco em uso pelo parser (só a thread consumidora mexe)
+    const char* cur = nullptr;
+    size_t len = 0, pos = 0;
+    bool holding = false;
+};
+
+} // namespace tabueqcol
@@ -20,7 +20,17 @@
 #include <random>
 #include <limits>
 #include <cassert>
+#include <atomic>
+#include <memory>
+#include <type_traits>
+#include <cmath>
+#include <queue>
 #include "stopCriterion.hpp"
+#include "parallel.hpp"
+#include "metrics.hpp"
+#include "class_pool.hpp"
+#include "memory.hpp"
+#include "portable.hpp"
 
 
 struct TabuConfig {
@@ -29,7 +39,36 @@ struct TabuConfig {
     int beta = 10;
     int perturbation_limit = 1000; // iterações sem melhora para perturbar
     double perturbation_strength = 0.16; // percentagem de n vértices a perturbar
+    int chain_moves = 0; // > 0: a perturbação aplica cadeias de ejeção (rebalance_equity) em vez de swaps aleatórios
     int aspiration = 1; // 0 = off, 1 = on
+    int time_check_every = 128; // iterações entre consultas ao relógio
+
+    // Variantes de kernel: mesmos movimentos (mesma trajetória para a mesma seed), custos diferentes.
+    // Escolhidas na calibração inicial (autotune.hpp) ou fixadas pela linha de comando.
+    int dense_counters = 0; // 1 = tabela n x k de vizinhos por cor: delta de move/swap em O(1)
+    int block_scan = 0;     // 1 = varredura de exchange em blocos vetorizáveis (requer dense_counters)
+    int threads = 1;        // threads na varredura de exchange (blocos contíguos de C(s))
+
+    // Vizinhança: 0 = completa (best improvement), 1 = amostrada (lista de candidatos),
+    // 2 = first improvement em ordem aleatória
+    int scan_mode = 0;
+    // Modo amostrado: por iteração, sample_vertices vértices de C(s); para cada um, sample_classes
+    // classes alvo e sample_partners parceiros de exchange sorteados em cada classe alvo.
+    int sample_vertices = 32;
+    int sample_classes = 8;
+    int sample_partners = 4;
+    int sample_adapt = 1;            // 1 = ajusta as amostras pela taxa de melhora e vazão
+    double sample_target_us = 200.0; // custo alvo por iteração (microssegundos)
+    // First improvement: após first_budget avaliações sem melhora, aplica o melhor movimento
+    // visto até ali (0 = sem limite, ou seja, cai no best improvement completo)
+    long long first_budget = 1 << 14;
+
+    // Métricas ao vivo (opcional): publicadas a cada time_check_every iterações
+    tabueqcol::SolverMetrics* metrics = nullptr;
+    // Pool de classes sem conflito (opcional): colhidas nos ótimos locais e ao fim da busca
+    tabueqcol::ClassPool* class_pool = nullptr;
+    // Retrato de memória (opcional): bytes por estrutura da busca no seu pico, antes da liberação
+    tabueqcol::PeakMemoryReport* memory_peak = nullptr;
 };
 
 
@@ -43,40 +82,247 @@ struct TabuResult {
     bool solved;           // Se chegou a custo 0
     int iterations;        // Quantas iterações rodou
     long long final_obj;   // Valor da Solução Final (SF)
+    double search_seconds = 0.0; // Tempo dentro do laço de busca (sem a preparação)
 };
 
 namespace tabueqcol {
 
+// Com k <= SMALL_K as cores presentes entre os vizinhos cabem numa palavra de 64 bits:
+// construções e transfers usam máscaras no lugar de uma varredura de N(v) por classe
+constexpr int SMALL_K = 64;
+
+// ------------------ Adjacência (CSR) ------------------
+// Faixa contígua de vizinhos de um vértice (ponteiros para dentro do CSR)
+struct NeighborRange {
+    const int* first = nullptr;
+    const int* last = nullptr;
+
+    const int* begin() const { return first; }
+    const int* end() const { return last; }
+    int size() const { return (int)(last - first); }
+    bool empty() const { return first == last; }
+};
+
+// Compressed Sparse Row: vizinhos de v em nbr[offset[v] .. offset[v+1]-1], ordenados e sem repetição.
+// adj[v] devolve um NeighborRange (iterável com range-for).
+struct CsrAdjacency {
+    std::vector<long long> offset; // n + 1 entradas
+    std::vector<int> nbr;          // 2m entradas
+
+    NeighborRange operator[](int v) const {
+        return { nbr.data() + offset[v], nbr.data() + offset[v + 1] };
+    }
+    int size() const { return offset.empty() ? 0 : (int)offset.size() - 1; }
+};
+
+// ------------------ Conceito de grafo ------------------
+// O solver é genérico sobre qualquer tipo G que exponha:
+//   int n, int max_degree
+//   int  degree(int v) const
+//   void for_each_neighbour(int v, F f) const   // f(u); se f devolve bool, false interrompe
+//   bool adjacent(int u, int v) const
+// Instance (CSR materializado) e os grafos implícitos de implicit_graphs.hpp seguem esse contrato.
+
+// Chama f(u) e informa se a enumeração deve continuar
+template <class F>
+inline bool visit_neighbour(F& f, int u) {
+    if constexpr (std::is_same_v<std::invoke_result_t<F&, int>, bool>) {
+        return f(u);
+    } else {
+        f(u);
+        return true;
+    }
+}
+
 // ------------------ Instance ------------------
 struct Instance {
     int n = 0;
-    std::vector<std::pair<int,int>> edges;
-    std::vector<std::vector<int>> adj;
-    std::vector<int> degree;
+    long long m = 0; // arestas distintas (após remover laços e repetidas)
+    std::vector<std::pair<int,int>> edges; // lista bruta da leitura; liberada por build_adj()
+    CsrAdjacency adj;
+    std::vector<int> degrees;
     int max_degree = 0;
 
     Instance() = default;
 
-    // Build adjacency after filling edges
-    void build_adj() {
-        adj.assign(n, {});
-        degree.assign(n, 0);
-        for (auto &e : edges) {
-            int a = e.first;
-            int b = e.second;
-            // assume 0-based vertices; if input is 1-based, convert earlier
-            adj[a].push_back(b);
-            adj[b].push_back(a);
-            degree[a]++; degree[b]++;
-            if(degree[a] > max_degree) max_degree = degree[a];
-            if(degree[b] > max_degree) max_degree = degree[b];
+    // --- Conceito de grafo ---
+    int degree(int v) const { return degrees[v]; }
+
+    template <class F>
+    void for_each_neighbour(int v, F&& f) const {
+        for (int u : adj[v]) {
+            if (!visit_neighbour(f, u)) return;
         }
     }
+
+    // Linhas do CSR são ordenadas: busca binária O(log grau)
+    bool adjacent(int u, int v) const {
+        auto r = adj[u];
+        return std::binary_search(r.begin(), r.end(), v);
+    }
+
+    // Build adjacency after filling edges
+    // Construção paralela do CSR:
+    //   1. contagem de graus (atômica)   2. soma de prefixo
+    //   3. scatter das arestas           4. libera a lista de arestas
+    //   5. ordenação + deduplicação por linha (grau e grau máximo saem daqui)
+    //   6. compactação das linhas
+    void build_adj(int threads = 0) {
+        CsrAdjacency raw = build_rows(threads);
+
+        // 6. Compacta as linhas deduplicadas no CSR final
+        adj.offset.assign(n + 1, 0);
+        parallel_for(0, n, [&](long long lo, long long hi, int) {
+            for (long long v = lo; v < hi; ++v) adj.offset[v] = degrees[v];
+        }, threads);
+        parallel_exclusive_scan(adj.offset, threads);
+
+        adj.nbr.resize(adj.offset[n]);
+        parallel_for(0, n, [&](long long lo, long long hi, int) {
+            for (long long v = lo; v < hi; ++v) {
+                std::copy(raw.nbr.begin() + raw.offset[v], raw.nbr.begin() + raw.offset[v] + degrees[v],
+                          adj.nbr.begin() + adj.offset[v]);
+            }
+        }, threads, 1 << 10);
+    }
+
+    // Passos 1-5 de build_adj: a linha v fica ordenada e sem repetição em
+    // nbr[offset[v] .. offset[v] + degrees[v]) (o resto da faixa sobra das repetidas).
+    // Preenche degrees, max_degree e m e libera a lista de arestas. Outras representações
+    // (CompressedGraph::from_edges) codificam direto destas linhas, sem o CSR compacto.
+    CsrAdjacency build_rows(int threads = 0) {
+        const long long num_raw = (long long)edges.size();
+        const std::pair<int,int>* E = edges.data();
+
+        // 1. Grau bruto (laços são descartados já aqui)
+        std::unique_ptr<std::atomic<long long>[]> cursor(new std::atomic<long long>[n + 1]);
+        parallel_for(0, n + 1, [&](long long lo, long long hi, int) {
+            for (long long v = lo; v < hi; ++v) cursor[v].store(0, std::memory_order_relaxed);
+        }, threads);
+        parallel_for(0, num_raw, [&](long long lo, long long hi, int) {
+            for (long long e = lo; e < hi; ++e) {
+                int a = E[e].first, b = E[e].second;
+                if (a == b) continue;
+                cursor[a].fetch_add(1, std::memory_order_relaxed);
+                cursor[b].fetch_add(1, std::memory_order_relaxed);
+            }
+        }, threads);
+
+        // 2. Offsets brutos
+        std::vector<long long> raw_offset(n + 1);
+        parallel_for(0, n, [&](long long lo, long long hi, int) {
+            for (long long v = lo; v < hi; ++v) raw_offset[v] = cursor[v].load(std::memory_order_relaxed);
+        }, threads);
+        parallel_exclusive_scan(raw_offset, threads);
+
+        // 3. Scatter: cada aresta reserva sua posição com fetch_add no cursor da linha
+        parallel_for(0, n, [&](long long lo, long long hi, int) {
+            for (long long v = lo; v < hi; ++v) cursor[v].store(raw_offset[v], std::memory_order_relaxed);
+        }, threads);
+        std::vector<int> raw_nbr(raw_offset[n]);
+        parallel_for(0, num_raw, [&](long long lo, long long hi, int) {
+            for (long long e = lo; e < hi; ++e) {
+                int a = E[e].first, b = E[e].second;
+                if (a == b) continue;
+                raw_nbr[cursor[a].fetch_add(1, std::memory_order_relaxed)] = b;
+                raw_nbr[cursor[b].fetch_add(1, std::memory_order_relaxed)] = a;
+            }
+        }, threads);
+        cursor.reset();
+
+        // 4. A lista bruta não é mais usada: sai antes de qualquer cópia das linhas
+        std::vector<std::pair<int,int>>().swap(edges);
+
+        // 5. Ordena e remove repetidas em cada linha; grau e grau máximo na mesma passada
+        degrees.assign(n, 0);
+        std::vector<int> thread_max(threads > 0 ? threads : default_thread_count(), 0);
+        parallel_for(0, n, [&](long long lo, long long hi, int tid) {
+            int local_max = 0;
+            for (long long v = lo; v < hi; ++v) {
+                int* b = raw_nbr.data() + raw_offset[v];
+                int* e = raw_nbr.data() + raw_offset[v + 1];
+                std::sort(b, e);
+                int d = (int)(std::unique(b, e) - b);
+                degrees[v] = d;
+                if (d > local_max) local_max = d;
+            }
+            if (local_max > thread_max[tid]) thread_max[tid] = local_max;
+        }, (int)thread_max.size(), 1 << 10);
+        max_degree = 0;
+        for (int x : thread_max) max_degree = std::max(max_degree, x);
+
+        long long total = 0;
+        for (int v = 0; v < n; ++v) total += degrees[v];
+        m = total / 2;
+
+        CsrAdjacency raw;
+        raw.offset = std::move(raw_offset);
+        raw.nbr = std::move(raw_nbr);
+        return raw;
+    }
+
+    void memory_report(MemoryReport& R) const {
+        R.add("instance.edges", vector_bytes(edges));
+        R.add("instance.adj.offset", vector_bytes(adj.offset));
+        R.add("instance.adj.nbr", vector_bytes(adj.nbr));
+        R.add("instance.degrees", vector_bytes(degrees));
+    }
+};
+
+// ------------------ Estado de uma busca em andamento ------------------
+// Tudo o que o laço do tabu mantém entre iterações. Com ele a busca pode ser pausada
+// após um número fixo de iterações e retomada depois (begin_search / step_search),
+// o que permite intercalar muitas buscas pequenas numa única thread.
+struct TabuRun {
+    TabuResult result{false, 0, 0, 0.0};
+    bool finished = false;
+    // true = finish_search mantém matriz tabu, contadores e listas (a busca é reaberta
+    // com resume_search quando a solução muda por fora, ver online.hpp)
+    bool persistent = false;
+
+    std::mt19937 rng;
+    int best_obj_found = 0;
+    int iter = 0;
+    int no_improve_iter = 0;
+
+    // Modo amostrado: 'sample_scale' é ajustado a cada janela
+    double sample_scale = 1.0;
+    int sample_nv = 0, sample_nc = 0, sample_np = 0;
+    int window_best = 0;
+    double window_t0 = 0.0;
+    std::vector<int> first_order; // permutação de C(s) reaproveitada (first improvement)
+    int metrics_iter = 0;         // última iteração publicada em config.metrics
+    long long work_charged = 0;   // parte de 'work' da solução já lançada no StopCriterion
+
+    // Varredura de exchange em paralelo: pool persistente + resultados por thread
+    std::unique_ptr<WorkerPool> pool;
+    std::vector<int> local_best;
+    std::vector<std::vector<CandidateMove>> local_cands;
+
+    // Granularidade adaptativa da varredura paralela (ver scan_threads): threads por nível,
+    // custo fixo de uma rodada do pool e custo efetivo por vértice de C(s) medidos por nível
+    std::vector<int> par_levels;       // 1, 2, 4, ..., config.threads
+    std::vector<double> par_overhead;  // segundos por rodada vazia do pool
+    std::vector<double> par_unit;      // segundos por vértice de C(s) (média móvel; < 0 = sem medida)
+    int par_level = 0;
+    int par_hold = 0;                  // iterações desde a última troca de nível (histerese)
+
+    // Tempo ativo: soma das fatias executadas (não conta o tempo em pausa)
+    double active_seconds = 0.0;
+    std::chrono::high_resolution_clock::time_point slice_start;
+
+    double elapsed() const {
+        std::chrono::duration<double> d = std::chrono::high_resolution_clock::now() - slice_start;
+        return active_seconds + d.count();
+    }
 };
 
 // ------------------ SolutionManager ------------------
-struct SolutionManager {
-    const Instance* inst = nullptr;
+// Parametrizado pelo tipo de grafo (ver "Conceito de grafo" acima): Instance (CSR) ou
+// um grafo implícito. Todas as chamadas são resolvidas em tempo de compilação.
+template <class Graph>
+struct BasicSolutionManager {
+    const Graph* inst = nullptr;
     int n = 0;
     int k = 0;
 
@@ -89,18 +335,21 @@ struct SolutionManager {
     std::vector<int> conflictingIndex; // -1 if not present
     // objective: number of conflicting edges (sum |E(Vi)|)
     long long obj = 0;
+    // Unidades de trabalho determinísticas (BUDGET_WORK, stopCriterion.hpp): entradas de
+    // adjacência percorridas em apply_move + vértices de C(s) avaliados por iteração
+    long long work = 0;
 
     // precomputed floor sizes for equity
     int floor_size = 0;
     int big_size = 0; // floor_size + 1
 
     // constructor: empty initialization for given instance and k
-    SolutionManager() = default;
-    SolutionManager(const Instance& I, int K = -1) {
+    BasicSolutionManager() = default;
+    BasicSolutionManager(const Graph& I, int K = -1) {
         init(&I, K);
     }
 
-    void init(const Instance* Iptr, int K = -1) {
+    void init(const Graph* Iptr, int K = -1) {
         auto t1 = std::chrono::high_resolution_clock::now();
         inst = Iptr;
         n = inst->n;
@@ -152,6 +401,12 @@ struct SolutionManager {
 
         std::shuffle(vertices.begin(), vertices.end(), rng);
 
+        if (k <= SMALL_K) {
+            if (place_greedy_small_k(vertices, current_r, rng)) rebalance_equity();
+            return;
+        }
+
+        bool overflowed = false;
         for (int v : vertices) {
             // Regra do M: Se ainda precisamos de classes grandes, permitimos floor+1
             // Se já atingimos o limite de classes grandes, travamos em floor
@@ -175,13 +430,14 @@ struct SolutionManager {
             // não deve ter vizinhos na cor c.
             for (int c : I) {
                 bool conflictFound = false;
-                for (int u : inst->adj[v]) {
+                inst->for_each_neighbour(v, [&](int u) {
                     // Só checamos vizinhos que JÁ foram coloridos
                     if (color[u] == c) {
                         conflictFound = true;
-                        break;
+                        return false;
                     }
-                }
+                    return true;
+                });
                 if (!conflictFound) {
                     chosenColor = c;
                     break;
@@ -191,10 +447,10 @@ struct SolutionManager {
             // Se não for possível, escolher aleatoriamente em I
             if (chosenColor == -1) {
                 if (I.empty()) {
-                    // Fallback de segurança (teoricamente não deve acontecer se K for viável pra equidade básica)
-                    // Escolhe a cor com menor tamanho atual
-                    chosenColor = 0; 
-                    for(int c=1; c<k; ++c) if(classSize[c] < classSize[chosenColor]) chosenColor = c;
+                    // Nenhuma classe aceita v pelo tamanho: classe sem conflito fora da regra do M
+                    // e reequilíbrio no fim
+                    chosenColor = overflow_class(v);
+                    overflowed = true;
                 } else {
                     std::uniform_int_distribution<int> dist(0, (int)I.size() - 1);
                     chosenColor = I[dist(rng)];
@@ -212,7 +468,7 @@ struct SolutionManager {
 
             // ATUALIZAÇÃO INCREMENTAL DE CONFLITOS E OBJETIVO
             // Como acabamos de colorir v, verificamos seus vizinhos já coloridos
-            for (int u : inst->adj[v]) {
+            inst->for_each_neighbour(v, [&](int u) {
                 if (color[u] != -1) { // Vizinho já colorido
                     if (color[u] == chosenColor) {
                         // Novo conflito gerado na aresta (u, v)
@@ -233,14 +489,15 @@ struct SolutionManager {
                         }
                     }
                 }
-            }
+            });
         }
+        if (overflowed) rebalance_equity();
     }
 
 
 // O objetivo é construir uma solução inicial para k cores a partir de uma solução conhecida para k+1 cores
     // Assume que 'this->k' é o alvo e 'prevSol.k' é k+1
-    void construct_greedy_from_previous(const SolutionManager& prevSol, int seed = 0) {
+    void construct_greedy_from_previous(const BasicSolutionManager& prevSol, int seed = 0) {
         // 1. Limpeza e Validações
         std::fill(color.begin(), color.end(), -1);
         std::fill(classSize.begin(), classSize.end(), 0);
@@ -324,12 +581,12 @@ struct SolutionManager {
                 // Abordagem segura para corrigir o 'obj':
                 // Subtraímos as arestas conflitantes onde v < u (para contar 1x cada aresta)
                 if (prevSol.conflicts[v] > 0) {
-                     for (int u : inst->adj[v]) {
+                     inst->for_each_neighbour(v, [&](int u) {
                         // Se u também era da cor removida e u > v, essa aresta contava no obj
                         if (u > v && prevSol.color[u] == removed_color) {
                             this->obj--; 
                         }
-                     }
+                     });
                 }
 
                 // O vértice v agora está sem cor, então conflitos são 0
@@ -366,6 +623,12 @@ struct SolutionManager {
 
         std::shuffle(uncolored_vertices.begin(), uncolored_vertices.end(), rng);
 
+        if (k <= SMALL_K) {
+            if (place_greedy_small_k(uncolored_vertices, current_r, rng)) rebalance_equity();
+            return;
+        }
+
+        bool overflowed = false;
         for (int v : uncolored_vertices) {
             // Define M (teto atual permitido)
             int M = (current_r < max_r) ? (floor_nk + 1) : floor_nk;
@@ -383,12 +646,13 @@ struct SolutionManager {
             // Tenta encontrar cor em I que não aumente conflitos
             for (int c : I) {
                 bool wouldIncrement = false;
-                for (int u : inst->adj[v]) {
+                inst->for_each_neighbour(v, [&](int u) {
                     if (color[u] == c) {
                         wouldIncrement = true;
-                        break;
+                        return false;
                     }
-                }
+                    return true;
+                });
                 if (!wouldIncrement) {
                     chosenColor = c;
                     break;
@@ -398,8 +662,10 @@ struct SolutionManager {
             // Se falhar, escolhe aleatório em I
             if (chosenColor == -1) {
                 if (I.empty()) {
-                   // Fallback extremo (não deve ocorrer se matemática estiver ok)
-                   chosenColor = 0; 
+                    // Nenhuma classe aceita v pelo tamanho: classe sem conflito fora da regra do M
+                    // e reequilíbrio no fim
+                    chosenColor = overflow_class(v);
+                    overflowed = true;
                 } else {
                     std::uniform_int_distribution<int> dist(0, (int)I.size() - 1);
                     chosenColor = I[dist(rng)];
@@ -414,7 +680,7 @@ struct SolutionManager {
             }
 
             // Atualiza conflitos incrementais (apenas para o vértice recém inserido)
-            for (int u : inst->adj[v]) {
+            inst->for_each_neighbour(v, [&](int u) {
                 if (color[u] != -1) { // Vizinho já colorido (herdado ou recém inserido)
                     if (color[u] == chosenColor) {
                         obj++; 
@@ -431,18 +697,311 @@ struct SolutionManager {
                         }
                     }
                 }
+            });
+        }
+        if (overflowed) rebalance_equity();
+    }
+
+
+    // ---------- k <= SMALL_K: cores da vizinhança numa máscara ----------
+
+    // Uma varredura de N(v): devolve a máscara das cores presentes (vizinhos sem cor são
+    // ignorados) e cnt[c] = vizinhos com cor c. Só as posições presentes são escritas:
+    // fora da máscara a contagem é 0 e cnt[c] não deve ser lido.
+    uint64_t neighbour_colors(int v, int* cnt) const {
+        uint64_t present = 0;
+        inst->for_each_neighbour(v, [&](int u) {
+            int c = color[u];
+            if (c < 0) return;
+            uint64_t bit = 1ULL << c;
+            if (!(present & bit)) {
+                present |= bit;
+                cnt[c] = 0;
+            }
+            cnt[c]++;
+        });
+        return present;
+    }
+
+    // Procedimento 1 (regra do M) para k <= SMALL_K, nos vértices de 'order' (sem cor).
+    // As classes que aceitam mais um vértice viram duas máscaras mantidas a cada inserção
+    // (tamanho < floor e tamanho == floor); a menor classe elegível sem vizinhos de v é
+    // ctz(elegíveis & ~presentes). Mesmas escolhas (e mesmos sorteios) do laço genérico.
+    // Devolve true se algum vértice ficou fora da regra do M (overflow_class).
+    bool place_greedy_small_k(const std::vector<int>& order, int& current_r, std::mt19937& rng) {
+        const int floor_nk = n / k;
+        const int max_r = n - k * floor_nk;
+        uint64_t below = 0, at_floor = 0;
+        for (int c = 0; c < k; ++c) {
+            if (classSize[c] < floor_nk) below |= 1ULL << c;
+            else if (classSize[c] == floor_nk) at_floor |= 1ULL << c;
+        }
+
+        int cnt[SMALL_K];
+        bool overflowed = false;
+        for (int v : order) {
+            uint64_t eligible = current_r < max_r ? (below | at_floor) : below;
+            uint64_t present = neighbour_colors(v, cnt);
+            uint64_t free_classes = eligible & ~present;
+
+            int chosenColor;
+            if (free_classes) {
+                chosenColor = ctz64(free_classes);
+            } else if (eligible) {
+                // i-ésima classe elegível, como I[dist(rng)] no laço genérico
+                std::uniform_int_distribution<int> dist(0, popcount64(eligible) - 1);
+                for (int i = dist(rng); i > 0; --i) eligible &= eligible - 1;
+                chosenColor = ctz64(eligible);
+            } else {
+                chosenColor = overflow_class(v);
+                overflowed = true;
+            }
+
+            color[v] = chosenColor;
+            const uint64_t bit = 1ULL << chosenColor;
+            int size = ++classSize[chosenColor];
+            if (size == floor_nk) {
+                below &= ~bit;
+                at_floor |= bit;
+            } else if (size == floor_nk + 1) {
+                at_floor &= ~bit;
+                current_r++;
+            }
+
+            // Sem vizinhos na cor escolhida: nada a atualizar (evita a segunda varredura)
+            if (!(present & bit)) continue;
+            inst->for_each_neighbour(v, [&](int u) {
+                if (color[u] != chosenColor) return;
+                obj++;
+                conflicts[v]++;
+                conflicts[u]++;
+                update_conflict_status(v);
+                update_conflict_status(u);
+            });
+        }
+        return overflowed;
+    }
+
+    // Carrega uma coloração pronta (cores em [0, k)) e recalcula conflitos, f, C(s) e tamanhos
+    // Complexidade: O(n + m)
+    void compute_from_coloring(const std::vector<int>& init_color) {
+        color = init_color;
+        std::fill(classSize.begin(), classSize.end(), 0);
+        conflictingVertices.clear();
+        std::fill(conflictingIndex.begin(), conflictingIndex.end(), -1);
+        obj = 0;
+
+        for (int v = 0; v < n; ++v) {
+            classSize[color[v]]++;
+            int cnt = 0;
+            inst->for_each_neighbour(v, [&](int u) { if (color[u] == color[v]) ++cnt; });
+            conflicts[v] = cnt;
+            obj += cnt;
+            if (cnt > 0) {
+                conflictingIndex[v] = conflictingVertices.size();
+                conflictingVertices.push_back(v);
+            }
+        }
+        obj /= 2;
+    }
+
+    // ---------- Equidade: reequilíbrio por caminhos de aumento ----------
+
+    // Tamanhos em {floor, floor + 1} com exatamente n mod k classes grandes
+    bool is_equitable() const {
+        const int f = n / k, r = n - k * f;
+        int big = 0;
+        for (int c = 0; c < k; ++c) {
+            if (classSize[c] < f || classSize[c] > f + 1) return false;
+            if (classSize[c] == f + 1) big++;
+        }
+        return big == r;
+    }
+
+    // Destino de um vértice que a regra do M não aceita em classe nenhuma: a menor classe
+    // sem vizinhos de v (de qualquer tamanho) ou, se não houver, a menor classe. A equidade
+    // é restaurada no fim da construção por rebalance_equity().
+    int overflow_class(int v) const {
+        std::vector<char> taken(k, 0);
+        inst->for_each_neighbour(v, [&](int u) { if (color[u] >= 0) taken[color[u]] = 1; });
+        int best = -1;
+        for (int c = 0; c < k; ++c) {
+            if (!taken[c] && (best < 0 || classSize[c] < classSize[best])) best = c;
+        }
+        if (best < 0) best = (int)(std::min_element(classSize.begin(), classSize.end()) - classSize.begin());
+        return best;
+    }
+
+    // Restaura a equidade com transfers encadeados. Grafo sobre as k classes: fontes (excesso)
+    // e sumidouros (falta); a aresta c -> d custa o menor número de conflitos novos de algum
+    // vértice de c indo para d (0 quando algum v de c não tem vizinhos em d). Cada aumento é
+    // um caminho de custo mínimo (Dijkstra) de uma fonte a um sumidouro, v1: c0 -> c1,
+    // v2: c1 -> c2, ...: só as pontas mudam de tamanho e o desequilíbrio cai de 1. Relaxar
+    // uma classe custa O(volume da classe + k). 'locked' (opcional) não é movido.
+    // Devolve o número de transfers aplicados.
+    long long rebalance_equity(int locked = -1) {
+        const int f = n / k, r = n - k * f;
+        std::vector<std::vector<int>> members(k);
+        std::vector<int> pos(n);
+        for (int v = 0; v < n; ++v) {
+            pos[v] = (int)members[color[v]].size();
+            members[color[v]].push_back(v);
+        }
+        auto relocate = [&](int v, int d) {
+            auto& from = members[color[v]];
+            int p = pos[v];
+            from[p] = from.back();
+            pos[from[p]] = p;
+            from.pop_back();
+            pos[v] = (int)members[d].size();
+            members[d].push_back(v);
+            apply_move(v, d);
+        };
+
+        const long long INF = std::numeric_limits<long long>::max();
+        std::vector<long long> dist(k);
+        std::vector<int> parent(k);
+        std::vector<char> settled(k);
+        // Por vértice: nb[d] = vizinhos em d. Por classe: present[d] = vértices com vizinho
+        // em d, least[d] = menor nb[d] entre eles (é o custo quando todos têm vizinho em d)
+        std::vector<int> nb(k, 0), present(k, 0), least(k, 0);
+        std::vector<int> touched_v, touched_c;
+        using Item = std::pair<long long, int>;
+
+        long long moves = 0;
+        for (int round = 0; round <= n; ++round) {
+            int big = 0;
+            for (int c = 0; c < k; ++c) big += classSize[c] >= f + 1;
+            auto is_source = [&](int c) { return classSize[c] > f + 1 || (classSize[c] == f + 1 && big > r); };
+            auto is_sink = [&](int c) { return classSize[c] < f || (classSize[c] == f && big < r); };
+
+            std::priority_queue<Item, std::vector<Item>, std::greater<Item>> pq;
+            std::fill(dist.begin(), dist.end(), INF);
+            std::fill(settled.begin(), settled.end(), 0);
+            for (int c = 0; c < k; ++c) {
+                if (is_source(c)) {
+                    dist[c] = 0;
+                    parent[c] = -1;
+                    pq.push({0, c});
+                }
+            }
+            if (pq.empty()) break; // equitativa
+
+            int sink = -1;
+            while (!pq.empty()) {
+                auto [dc, c] = pq.top();
+                pq.pop();
+                if (settled[c]) continue;
+                settled[c] = 1;
+                if (is_sink(c)) {
+                    sink = c;
+                    break;
+                }
+                int movable = 0;
+                for (int v : members[c]) {
+                    if (v == locked) continue;
+                    movable++;
+                    inst->for_each_neighbour(v, [&](int u) {
+                        int d = color[u];
+                        if (nb[d]++ == 0) touched_v.push_back(d);
+                    });
+                    for (int d : touched_v) {
+                        if (present[d]++ == 0) {
+                            touched_c.push_back(d);
+                            least[d] = nb[d];
+                        } else {
+                            least[d] = std::min(least[d], nb[d]);
+                        }
+                        nb[d] = 0;
+                    }
+                    touched_v.clear();
+                }
+                if (movable > 0) {
+                    for (int d = 0; d < k; ++d) {
+                        if (settled[d]) continue;
+                        long long w = present[d] < movable ? 0 : least[d];
+                        if (dc + w < dist[d]) {
+                            dist[d] = dc + w;
+                            parent[d] = c;
+                            pq.push({dist[d], d});
+                        }
+                    }
+                }
+                for (int d : touched_c) present[d] = 0;
+                touched_c.clear();
+            }
+            if (sink < 0) break; // só classes sem vértices móveis alcançáveis
+
+            // Da ponta para a fonte: em cada salto p -> q, o vértice de p com menos vizinhos
+            // em q (empate: o que tem mais conflitos em p, que saem com ele)
+            for (int q = sink; parent[q] >= 0; q = parent[q]) {
+                const int p = parent[q];
+                int best_v = -1, best_cnt = 0;
+                for (int v : members[p]) {
+                    if (v == locked) continue;
+                    int cnt = 0;
+                    inst->for_each_neighbour(v, [&](int u) { if (color[u] == q) ++cnt; });
+                    if (best_v < 0 || cnt < best_cnt || (cnt == best_cnt && conflicts[v] > conflicts[best_v])) {
+                        best_v = v;
+                        best_cnt = cnt;
+                    }
+                }
+                relocate(best_v, q);
+                moves++;
             }
         }
+        return moves;
+    }
+
+    // Movimento grande (cadeia de ejeção): v vai para a classe com menos vizinhos, sem olhar
+    // o tamanho, e a equidade volta por caminhos de aumento sem mexer em v.
+    // Devolve os transfers aplicados.
+    long long ejection_chain(int v) {
+        std::vector<int> cnt(k, 0);
+        inst->for_each_neighbour(v, [&](int u) { cnt[color[u]]++; });
+        int best = -1;
+        for (int d = 0; d < k; ++d) {
+            if (d == color[v]) continue;
+            if (best < 0 || cnt[d] < cnt[best] || (cnt[d] == cnt[best] && classSize[d] < classSize[best])) best = d;
+        }
+        if (best < 0) return 0;
+        const int old_c = color[v];
+        apply_move(v, best);
+        long long moves = 1 + rebalance_equity(v);
+        if (!is_equitable()) {
+            // Só v podia sair da classe cheia: desfaz e reequilibra sem trava
+            apply_move(v, old_c);
+            moves += 1 + rebalance_equity();
+        }
+        return moves;
+    }
+
+    // ---------- Contadores densos de cor (gamma) ----------
+    // gamma[v*k + c] = número de vizinhos de v com cor c. Vazio = desligado.
+    // Só existe durante run_tabu_search (as construções não o mantêm).
+    std::vector<int> gamma;
+
+    void build_color_counters() {
+        gamma.assign((size_t)n * k, 0);
+        parallel_for(0, n, [&](long long lo, long long hi, int) {
+            for (long long v = lo; v < hi; ++v) {
+                int* gv = gamma.data() + (size_t)v * k;
+                inst->for_each_neighbour((int)v, [&](int u) { gv[color[u]]++; });
+            }
+        }, 0, 1 << 12);
     }
 
+    void release_color_counters() {
+        std::vector<int>().swap(gamma);
+    }
 
     // ---------- helper: recompute objective from scratch (for debug) ----------
     long long recompute_objective_slow() const {
         long long sum = 0;
         for (int v = 0; v < n; ++v) {
-            for (int u : inst->adj[v]) {
+            inst->for_each_neighbour(v, [&](int u) {
                 if (color[v] == color[u]) sum++;
-            }
+            });
         }
         return sum / 2;
     }
@@ -460,7 +1019,7 @@ struct SolutionManager {
         // check conflicts vector
         for (int v = 0; v < n; ++v) {
             int cnt = 0;
-            for (int u : inst->adj[v]) if (color[u] == color[v]) ++cnt;
+            inst->for_each_neighbour(v, [&](int u) { if (color[u] == color[v]) ++cnt; });
             if (cnt != conflicts[v]) return false;
         }
         // check obj
@@ -495,14 +1054,19 @@ struct SolutionManager {
     // Calcula variação de conflitos ao mover v de old_c para new_c
     // Complexidade: O(grau(v))
     int get_move_delta(int v, int old_c, int new_c) const {
+        if (!gamma.empty()) {
+            // O(1) com contadores densos
+            const int* gv = gamma.data() + (size_t)v * k;
+            return gv[new_c] - gv[old_c];
+        }
         int delta = 0;
-        for (int u : inst->adj[v]) {
+        inst->for_each_neighbour(v, [&](int u) {
             int c_u = color[u];
-            if (c_u == -1) continue;
+            if (c_u == -1) return;
             
             if (c_u == old_c) delta--; // Removeria um conflito existente
             else if (c_u == new_c) delta++; // Criaria um novo conflito
-        }
+        });
         return delta;
     }
 
@@ -515,24 +1079,34 @@ struct SolutionManager {
         // Se tiverem a mesma cor, custo não muda (movimento inútil que não deveria acontecer)
         if (c_v == c_u) return 0;
 
+        if (!gamma.empty()) {
+            // O(1) + teste de adjacência: a aresta (u,v) aparece nos dois contadores e é descontada.
+            // Se v não tem vizinhos de cor c_u, u (que tem cor c_u) não pode ser vizinho de v.
+            const int* gv = gamma.data() + (size_t)v * k;
+            const int* gu = gamma.data() + (size_t)u * k;
+            int delta = (gv[c_u] - gv[c_v]) + (gu[c_v] - gu[c_u]);
+            if (gv[c_u] > 0 && inst->adjacent(u, v)) delta -= 2;
+            return delta;
+        }
+
         int delta = 0;
 
         // 1. Variação para v (saindo de c_v indo para c_u)
         // Ignoramos 'u' aqui temporariamente para tratar aresta (u,v) separadamente
-        for (int w : inst->adj[v]) {
-            if (w == u) continue; // Trata aresta direta depois
+        inst->for_each_neighbour(v, [&](int w) {
+            if (w == u) return; // Trata aresta direta depois
             int c_w = color[w];
             if (c_w == c_v) delta--; // Perde conflito atual
             else if (c_w == c_u) delta++; // Ganha conflito novo
-        }
+        });
 
         // 2. Variação para u (saindo de c_u indo para c_v)
-        for (int w : inst->adj[u]) {
-            if (w == v) continue;
+        inst->for_each_neighbour(u, [&](int w) {
+            if (w == v) return;
             int c_w = color[w];
             if (c_w == c_u) delta--; // Perde conflito atual
             else if (c_w == c_v) delta++; // Ganha conflito novo
-        }
+        });
 
         // A aresta (u, v) nunca gera ou remove conflito no SWAP de cores distintas.
         // Antes: v(c_v) - u(c_u). Diferentes. Sem conflito.
@@ -549,19 +1123,36 @@ struct SolutionManager {
     // Atualiza estruturas de dados após mover v de old_c para new_c
     void apply_move(int v, int new_c) {
         int old_c = color[v];
+        work += 2LL * inst->degree(v) + 1;
         
         // 1. Atualiza cor e tamanhos
         color[v] = new_c;
         classSize[old_c]--;
         classSize[new_c]++;
 
+        if (!classMembers.empty()) {
+            // Remove O(1) da lista da cor antiga (swap com o último) e insere na nova
+            auto& from = classMembers[old_c];
+            int pos = memberPos[v];
+            from[pos] = from.back();
+            memberPos[from[pos]] = pos;
+            from.pop_back();
+            memberPos[v] = (int)classMembers[new_c].size();
+            classMembers[new_c].push_back(v);
+        }
+
         // 2. Atualiza conflitos dos vizinhos e do próprio v
         // Precisamos recalcular conflitos de v do zero ou incrementalmente?
         // Incremental é mais seguro se feito com cuidado.
         
         // Primeiro, limpamos os conflitos que v tinha na cor antiga
         // E removemos v da contagem de conflitos dos vizinhos
-        for (int u : inst->adj[v]) {
+        int* g = gamma.empty() ? nullptr : gamma.data();
+        inst->for_each_neighbour(v, [&](int u) {
+            if (g) {
+                g[(size_t)u * k + old_c]--;
+                g[(size_t)u * k + new_c]++;
+            }
             if (color[u] == old_c) {
                 // v e u colidiam. Agora não colidem mais.
                 obj--; // Aresta resolvida
@@ -571,10 +1162,10 @@ struct SolutionManager {
                 conflicts[u]--;
                 update_conflict_status(u);
             }
-        }
+        });
 
         // Agora adicionamos os conflitos na nova cor
-        for (int u : inst->adj[v]) {
+        inst->for_each_neighbour(v, [&](int u) {
             if (color[u] == new_c) {
                 // v e u agora colidem
                 obj++;
@@ -584,9 +1175,57 @@ struct SolutionManager {
                 conflicts[u]++;
                 update_conflict_status(u);
             }
+        });
+    }
+
+
+    // ---------- Crescimento da instância (modo online, online.hpp) ----------
+
+    // Acrescenta o vértice n com a cor c. O grafo já deve ter o vértice novo (inst->n == n + 1).
+    // Atualiza conflitos, f, C(s), tamanhos e as estruturas auxiliares existentes. O(grau)
+    void append_vertex(int c) {
+        int v = n++;
+        floor_size = n / k;
+        big_size = floor_size + 1;
+
+        color.push_back(c);
+        classSize[c]++;
+        conflicts.push_back(0);
+        conflictingIndex.push_back(-1);
+        if (!tabu_matrix.empty()) tabu_matrix.emplace_back(k, 0);
+        if (!classMembers.empty()) {
+            memberPos.push_back((int)classMembers[c].size());
+            classMembers[c].push_back(v);
         }
+        if (!gamma.empty()) gamma.resize((size_t)n * k, 0);
+
+        int* g = gamma.empty() ? nullptr : gamma.data();
+        inst->for_each_neighbour(v, [&](int u) {
+            if (g) {
+                g[(size_t)u * k + c]++;
+                g[(size_t)v * k + color[u]]++;
+            }
+            if (color[u] == c) {
+                obj++;
+                conflicts[v]++;
+                conflicts[u]++;
+                update_conflict_status(u);
+            }
+        });
+        update_conflict_status(v);
     }
 
+    // Acrescenta uma classe vazia (cor k). A equidade só volta depois que quem chama mover
+    // vértices para ela (apply_move). O(n) pela matriz tabu; os contadores densos são refeitos.
+    void append_color() {
+        k++;
+        floor_size = n / k;
+        big_size = floor_size + 1;
+        classSize.push_back(0);
+        if (!classMembers.empty()) classMembers.emplace_back();
+        for (auto& row : tabu_matrix) row.push_back(0);
+        if (!gamma.empty()) build_color_counters();
+    }
 
     // Helper auxiliar lento mas seguro para SWAP (chamar só dentro do apply_swap)
     // Para implementação de alta performance, expanda a lógica incremental.
@@ -631,39 +1270,602 @@ struct SolutionManager {
         }
     }
 
+    // ==============================================================
+    // VARREDURA DA VIZINHANÇA DE TRANSFER (MOVE)
+    // ==============================================================
+
+    // Avalia todos os moves v (em C(s) e W+) -> j (em W-)
+    void scan_transfer(int iter, int best_obj_found, int& best_delta,
+                       std::vector<CandidateMove>& candidates, const TabuConfig& config) const {
+        bool can_do_transfer = (n % k != 0); 
+
+        if (can_do_transfer && k <= SMALL_K && gamma.empty()) {
+            // Uma varredura de N(v) por vértice no lugar de uma por classe alvo: delta sai da
+            // contagem por cor, e os alvos sem conflito são W- & ~presentes
+            uint64_t w_minus = 0;
+            for (int j = 0; j < k; ++j) {
+                if (classSize[j] == floor_size) w_minus |= 1ULL << j;
+            }
+            int cnt[SMALL_K];
+            for (int v : conflictingVertices) {
+                int c_v = color[v];
+                if (classSize[c_v] != big_size) continue;
+                uint64_t present = neighbour_colors(v, cnt);
+                int own = cnt[c_v];
+                for (uint64_t targets = w_minus; targets; targets &= targets - 1) {
+                    int j = ctz64(targets);
+                    int delta = ((present >> j) & 1 ? cnt[j] : 0) - own;
+                    bool is_tabu = (tabu_matrix[v][j] > iter);
+                    bool aspiration = (obj + delta < best_obj_found);
+                    if (!is_tabu || (aspiration && config.aspiration)) {
+                        if (delta < best_delta) {
+                            best_delta = delta;
+                            candidates.clear();
+                            candidates.push_back({0, v, j});
+                        } else if (delta == best_delta) {
+                            candidates.push_back({0, v, j});
+                        }
+                    }
+                }
+            }
+            return;
+        }
+
+        if (can_do_transfer) {
+            // Candidatos: v pertencente a C(s) AND v está numa classe W+
+            // Iterar sobre conflictingVertices
+            for (int v : conflictingVertices) {
+                int c_v = color[v];
+                if (classSize[c_v] == big_size) { // v está em W+
+                    // Tentar mover para qualquer j em W-
+                    for (int j = 0; j < k; ++j) {
+                        if (classSize[j] == floor_size) { // j está em W-
+                            int delta = get_move_delta(v, c_v, j);
+                            
+                            // Tabu Check
+                            bool is_tabu = (tabu_matrix[v][j] > iter);
+                            // Aspiration Check
+                            bool aspiration = (obj + delta < best_obj_found);
+                            
+                            if (!is_tabu || (aspiration && config.aspiration)) {
+
+
+                                if (delta < best_delta) {
+                                    best_delta = delta;
+                                    candidates.clear(); // Limpa candidatos anteriores
+                                    candidates.push_back({0, v, j}); // Adiciona o novo
+                                }
+                                else if (delta == best_delta) {
+                                    // Empate: adiciona como candidato
+                                    candidates.push_back({0, v, j});
+                                }
+                                // Melhoria de primeiro nível (First Improvement) pode ser mais rápida?
+                                // Tabu geralmente usa Best Improvement na vizinhança.
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    // ==============================================================
+    // VIZINHANÇA AMOSTRADA (LISTA DE CANDIDATOS)
+    // ==============================================================
+
+    // Custo limitado por iteração, independente de n: nv vértices de C(s) x nc classes alvo
+    // x (1 transfer + np parceiros de exchange da classe alvo). Mesmas regras de tabu e
+    // aspiração da vizinhança completa.
+    void sample_neighbourhood(int iter, int best_obj_found, int& best_delta,
+                              std::vector<CandidateMove>& candidates, const TabuConfig& config,
+                              int nv, int nc, int np, std::mt19937& rng) const {
+        const int num_conflicting = (int)conflictingVertices.size();
+        if (num_conflicting == 0 || k < 2) return;
+        const bool can_do_transfer = (n % k != 0);
+
+        auto record = [&](int type, int v, int target, int delta) {
+            if (delta < best_delta) {
+                best_delta = delta;
+                candidates.clear();
+                candidates.push_back({type, v, target});
+            } else if (delta == best_delta) {
+                candidates.push_back({type, v, target});
+            }
+        };
+
+        // Amostras maiores que a população viram varredura completa dela
+        const bool all_vertices = nv >= num_conflicting;
+        const bool all_classes = nc >= k - 1;
+        if (all_vertices) nv = num_conflicting;
+        if (all_classes) nc = k - 1;
+
+        std::uniform_int_distribution<int> d_cv(0, num_conflicting - 1);
+        std::uniform_int_distribution<int> d_other(0, k - 2);
+
+        for (int s = 0; s < nv; ++s) {
+            int v = all_vertices ? conflictingVertices[s] : conflictingVertices[d_cv(rng)];
+            int c_v = color[v];
+            bool v_in_big = (classSize[c_v] == big_size);
+            // k <= SMALL_K sem contadores densos: uma varredura de N(v) serve a todas as classes
+            int cnt[SMALL_K];
+            uint64_t present = 0;
+            const bool small_k = can_do_transfer && v_in_big && k <= SMALL_K && gamma.empty();
+            if (small_k) present = neighbour_colors(v, cnt);
+
+            for (int t = 0; t < nc; ++t) {
+                int j = all_classes ? t : d_other(rng);
+                if (j >= c_v) j++; // pula a própria cor
+
+                // Transfer v -> j (v em W+, j em W-)
+                if (can_do_transfer && v_in_big && classSize[j] == floor_size) {
+                    int delta = small_k ? ((present >> j) & 1 ? cnt[j] : 0) - cnt[c_v] : get_move_delta(v, c_v, j);
+                    bool is_tabu = (tabu_matrix[v][j] > iter);
+                    bool aspiration = (obj + delta < best_obj_found);
+                    if (!is_tabu || (aspiration && config.aspiration)) record(0, v, j, delta);
+                }
+
+                // Exchange com parceiros sorteados na classe j
+                const auto& members = classMembers[j];
+                int m = (int)members.size();
+                if (m == 0) continue;
+                int take = std::min(np, m);
+                std::uniform_int_distribution<int> d_m(0, m - 1);
+                for (int p = 0; p < take; ++p) {
+                    int u = (take == m) ? members[p] : members[d_m(rng)];
+                    int delta = get_swap_delta(v, u);
+                    bool is_tabu = (tabu_matrix[v][j] > iter) || (tabu_matrix[u][c_v] > iter);
+                    bool aspiration = (obj + delta < best_obj_found);
+                    if (!is_tabu || aspiration) record(1, v, u, delta);
+                }
+            }
+        }
+    }
+
+    // ==============================================================
+    // FIRST IMPROVEMENT EM ORDEM ALEATÓRIA
+    // ==============================================================
+
+    // Percorre C(s) em ordem aleatória (embaralhamento preguiçoso: só paga pelos vértices
+    // visitados) e, para cada v, classes e parceiros a partir de um deslocamento aleatório.
+    // O primeiro movimento admissível com delta < 0 é devolvido sozinho; se nada melhora
+    // em 'first_budget' avaliações, fica o melhor da amostra (empates como candidatos).
+    // first_budget = 0 varre tudo e fica com os melhores (best improvement completo).
+    void scan_first_improvement(int iter, int best_obj_found, int& best_delta,
+                                std::vector<CandidateMove>& candidates, const TabuConfig& config,
+                                std::vector<int>& order, std::mt19937& rng) const {
+        const int num_conflicting = (int)conflictingVertices.size();
+        const bool can_do_transfer = (n % k != 0);
+        const bool full = config.first_budget <= 0;
+        const long long budget = full ? std::numeric_limits<long long>::max() : config.first_budget;
+        long long evaluated = 0;
+
+        // Devolve true quando a varredura deve parar
+        auto consider = [&](int type, int v, int target, int delta) {
+            evaluated++;
+            if (delta < 0 && !full) {
+                best_delta = delta;
+                candidates.assign(1, {type, v, target});
+                return true;
+            }
+            if (delta < best_delta) {
+                best_delta = delta;
+                candidates.clear();
+                candidates.push_back({type, v, target});
+            } else if (delta == best_delta) {
+                candidates.push_back({type, v, target});
+            }
+            return false;
+        };
+
+        order.assign(conflictingVertices.begin(), conflictingVertices.end());
+        std::uniform_int_distribution<int> d_k(0, k - 1);
+        std::uniform_int_distribution<int> d_n(0, n - 1);
+
+        for (int i = 0; i < num_conflicting; ++i) {
+            std::uniform_int_distribution<int> d_rest(i, num_conflicting - 1);
+            std::swap(order[i], order[d_rest(rng)]);
+            int v = order[i];
+            int c_v = color[v];
+
+            // Transfer v (W+) -> j (W-)
+            if (can_do_transfer && classSize[c_v] == big_size) {
+                int j0 = d_k(rng);
+                int cnt[SMALL_K];
+                uint64_t present = 0;
+                const bool small_k = k <= SMALL_K && gamma.empty();
+                if (small_k) present = neighbour_colors(v, cnt);
+                for (int t = 0; t < k; ++t) {
+                    int j = j0 + t < k ? j0 + t : j0 + t - k;
+                    if (classSize[j] != floor_size) continue;
+                    int delta = small_k ? ((present >> j) & 1 ? cnt[j] : 0) - cnt[c_v] : get_move_delta(v, c_v, j);
+                    bool is_tabu = (tabu_matrix[v][j] > iter);
+                    bool aspiration = (obj + delta < best_obj_found);
+                    if (!is_tabu || (aspiration && config.aspiration)) {
+                        if (consider(0, v, j, delta)) return;
+                    }
+                }
+            }
+
+            // Exchange (v, u), mesma regra de simetria da varredura completa
+            int u0 = d_n(rng);
+            for (int t = 0; t < n; ++t) {
+                int u = u0 + t < n ? u0 + t : u0 + t - n;
+                if (u == v) continue;
+                int c_u = color[u];
+                if (c_u == c_v) continue;
+                if (conflicts[u] > 0 && c_u > c_v) continue;
+                int delta = get_swap_delta(v, u);
+                bool is_tabu = (tabu_matrix[v][c_u] > iter) || (tabu_matrix[u][c_v] > iter);
+                bool aspiration = (obj + delta < best_obj_found);
+                if (!is_tabu || aspiration) {
+                    if (consider(1, v, u, delta)) return;
+                }
+                if (evaluated >= budget && !candidates.empty()) return;
+            }
+            if (evaluated >= budget && !candidates.empty()) return;
+        }
+    }
+
+    // ---------- Listas de membros por classe (modo amostrado) ----------
+    // classMembers[c] = vértices com cor c; memberPos[v] = posição de v na lista da sua cor.
+    // Vazias = desligado; existem só durante run_tabu_search.
+    std::vector<std::vector<int>> classMembers;
+    std::vector<int> memberPos;
+
+    // Bytes por estrutura desta solução (prefixo identifica a cópia: "best.", "current.")
+    void memory_report(MemoryReport& R, const std::string& prefix) const {
+        R.add(prefix + "color", vector_bytes(color));
+        R.add(prefix + "classSize", vector_bytes(classSize));
+        R.add(prefix + "conflicts", vector_bytes(conflicts));
+        R.add(prefix + "conflictingVertices", vector_bytes(conflictingVertices) + vector_bytes(conflictingIndex));
+        R.add(prefix + "tabu_matrix", vector_bytes(tabu_matrix));
+        R.add(prefix + "gamma", vector_bytes(gamma));
+        R.add(prefix + "classMembers", vector_bytes(classMembers) + vector_bytes(memberPos));
+    }
+
+    void build_class_members() {
+        classMembers.assign(k, {});
+        memberPos.assign(n, -1);
+        for (int c = 0; c < k; ++c) classMembers[c].reserve(classSize[c] + 1);
+        for (int v = 0; v < n; ++v) {
+            memberPos[v] = (int)classMembers[color[v]].size();
+            classMembers[color[v]].push_back(v);
+        }
+    }
+
+    void release_class_members() {
+        std::vector<std::vector<int>>().swap(classMembers);
+        std::vector<int>().swap(memberPos);
+    }
+
+    // ==============================================================
+    // VARREDURA DA VIZINHANÇA DE EXCHANGE
+    // ==============================================================
+
+    // Avalia os swaps (v, u) para v em conflictingVertices[lo..hi), acumulando em
+    // best_delta/candidates os melhores empatados na ordem de descoberta.
+    // Só lê o estado: pode rodar em paralelo sobre blocos disjuntos de C(s).
+    void scan_exchange(int lo, int hi, int iter, int best_obj_found, int& best_delta,
+                       std::vector<CandidateMove>& candidates, const TabuConfig& config) const {
+        if (!gamma.empty() && config.block_scan) {
+            scan_exchange_block(lo, hi, iter, best_obj_found, best_delta, candidates);
+            return;
+        }
+
+        for (int i = lo; i < hi; ++i) {
+            int v = conflictingVertices[i];
+            int c_v = color[v];
+            
+            // Iterar todos os vértices u para tentar troca
+            // (Em implementações avançadas, iteraríamos apenas u que tem cores diferentes e adjacências relevantes)
+            for (int u = 0; u < n; ++u) {
+                if (v == u) continue;
+                int c_u = color[u];
+                if (c_v == c_u) continue; // Mesma cor, inútil trocar
+
+                // Regra do artigo para evitar simetria e redundância
+                bool u_in_conflicts = (conflicts[u] > 0);
+                
+                // Se u também é conflitante, só checa se c_u < c_v para não testar o par (v,u) e depois (u,v)
+                if (u_in_conflicts && c_u > c_v) continue; 
+                
+                int delta = get_swap_delta(v, u);
+
+                // Tabu Check para Swap?
+                // Geralmente considera-se tabu se mover v para c_u OU mover u para c_v é tabu.
+                bool is_tabu = (tabu_matrix[v][c_u] > iter) || (tabu_matrix[u][c_v] > iter);
+                bool aspiration = (obj + delta < best_obj_found);
+
+                if (!is_tabu || aspiration) {
+                    if (delta < best_delta) {
+                        best_delta = delta;
+                        candidates.clear();
+                        candidates.push_back({1, v, u});
+                    }
+                    else if (delta == best_delta) {
+                        candidates.push_back({1, v, u});// Empate: adiciona como candidato
+                    }
+                }
+            }
+        }
+    }
+
+    // Mesma vizinhança com contadores densos, em blocos de u: a primeira passada calcula
+    // os deltas sem desvios (o compilador vetoriza com gathers), a segunda filtra e
+    // descarta cedo quem não alcança o melhor delta nem com a correção da aresta (u,v).
+    void scan_exchange_block(int lo, int hi, int iter, int best_obj_found, int& best_delta,
+                             std::vector<CandidateMove>& candidates) const {
+        constexpr int BLOCK = 256;
+        int dbuf[BLOCK];
+        const int* G = gamma.data();
+        const int* col = color.data();
+        const size_t kk = (size_t)k;
+
+        for (int i = lo; i < hi; ++i) {
+            int v = conflictingVertices[i];
+            int c_v = col[v];
+            const int* gv = G + (size_t)v * kk;
+            const int gvv = gv[c_v];
+            const auto& tabu_v = tabu_matrix[v];
+
+            for (int b = 0; b < n; b += BLOCK) {
+                int e = std::min(n, b + BLOCK);
+
+                for (int u = b; u < e; ++u) {
+                    int c_u = col[u];
+                    dbuf[u - b] = gv[c_u] - gvv + G[(size_t)u * kk + c_v] - G[(size_t)u * kk + c_u];
+                }
+
+                for (int u = b; u < e; ++u) {
+                    int delta = dbuf[u - b];
+                    if (delta - 2 > best_delta) continue;
+                    int c_u = col[u];
+                    if (c_u == c_v) continue; // inclui u == v
+                    if (conflicts[u] > 0 && c_u > c_v) continue;
+                    if (gv[c_u] > 0 && inst->adjacent(u, v)) delta -= 2;
+
+                    bool is_tabu = (tabu_v[c_u] > iter) || (tabu_matrix[u][c_v] > iter);
+                    bool aspiration = (obj + delta < best_obj_found);
+
+                    if (!is_tabu || aspiration) {
+                        if (delta < best_delta) {
+                            best_delta = delta;
+                            candidates.clear();
+                            candidates.push_back({1, v, u});
+                        }
+                        else if (delta == best_delta) {
+                            candidates.push_back({1, v, u});
+                        }
+                    }
+                }
+            }
+        }
+    }
+
     // ==============================================================
     // CORE DO TABU SEARCH
     // ==============================================================
 
     TabuResult run_tabu_search(const TabuConfig& config, const StopCriterion& stop, int seed = 0) {
+        // Contadores densos e listas por classe existem só durante a busca (liberados em qualquer saída)
+        struct AuxGuard {
+            BasicSolutionManager* s;
+            ~AuxGuard() { s->release_color_counters(); s->release_class_members(); }
+        } aux_guard{this};
+
+        TabuRun run;
+        begin_search(run, config, seed);
+        step_search(run, config, stop);
+        return run.result;
+    }
 
-        TabuResult result;
-        result.solved = false;
-        result.final_obj = obj;
-        result.iterations = 0;
-
+    // Prepara 'run' para uma nova busca a partir da solução atual
+    void begin_search(TabuRun& run, const TabuConfig& config, int seed = 0) {
+        run = TabuRun();
+        run.result.final_obj = obj;
+        run.slice_start = std::chrono::high_resolution_clock::now();
 
         if (obj == 0){
-            result.solved = true;
-            return result;
+            run.result.solved = true;
+            run.finished = true;
+            return;
         } // Já está ótimo
 
 
         init_tabu();
-        std::mt19937 rng(seed);
-        int best_obj_found = obj;
+        run.rng.seed(seed);
+        run.best_obj_found = obj;
+        run.work_charged = work;
+
+        if (config.dense_counters) build_color_counters();
+        if (config.scan_mode == 1) build_class_members();
+
+        run.sample_nv = config.sample_vertices;
+        run.sample_nc = config.sample_classes;
+        run.sample_np = config.sample_partners;
+        run.window_best = run.best_obj_found;
+
+        if (config.threads > 1) {
+            run.pool.reset(new WorkerPool(config.threads));
+            run.local_best.resize(config.threads);
+            run.local_cands.resize(config.threads);
+            calibrate_scan_levels(run, config.threads);
+        }
+    }
 
-        int iter = 0;
-        int no_improve_iter = 0; // Para critério de parada extra se quiser
+    // ---------- Granularidade da varredura paralela ----------
+    // Com |C(s)| pequeno (fim de um nível) a barreira do pool custa mais que a varredura.
+    // A cada iteração o número de threads vem do modelo tempo(nível) = custo fixo do pool +
+    // |C(s)| * custo por vértice daquele nível, ambos medidos nesta máquina; a troca exige
+    // ganho previsto de SCAN_HYSTERESIS e SCAN_HOLD iterações no nível atual. A junção em
+    // ordem de bloco não depende do número de threads: os movimentos escolhidos (e a
+    // trajetória para a mesma semente) são os mesmos em qualquer nível.
+    static constexpr double SCAN_HYSTERESIS = 0.15;
+    static constexpr int SCAN_HOLD = 8;
+    static constexpr int SCAN_REPROBE = 1024; // esquece as medidas dos outros níveis
+
+    // Custo fixo de cada nível: mediana de rodadas vazias do pool
+    static void calibrate_scan_levels(TabuRun& run, int threads) {
+        run.par_levels.clear();
+        for (int t = 1; t < threads; t *= 2) run.par_levels.push_back(t);
+        run.par_levels.push_back(threads);
+        const int L = (int)run.par_levels.size();
+        run.par_overhead.assign(L, 0.0);
+        run.par_unit.assign(L, -1.0);
+        std::vector<double> sample(15);
+        for (int i = 1; i < L; ++i) {
+            for (auto& x : sample) {
+                auto t0 = std::chrono::steady_clock::now();
+                run.pool->run(run.par_levels[i], [](int) {});
+                x = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+            }
+            std::nth_element(sample.begin(), sample.begin() + sample.size() / 2, sample.end());
+            run.par_overhead[i] = sample[sample.size() / 2];
+        }
+        run.par_level = 0;
+        run.par_hold = 0;
+    }
 
+    // Threads para a varredura desta iteração (com histerese)
+    static int scan_threads(TabuRun& run, int num_conflicting, int iter) {
+        const int L = (int)run.par_levels.size();
+        const int cur = run.par_level;
+        if (iter % SCAN_REPROBE == 0) {
+            for (int i = 0; i < L; ++i) if (i != cur) run.par_unit[i] = -1.0;
+        }
+        if (run.par_unit[cur] >= 0) {
+            // Sem medida: escala perfeita a partir do nível atual (otimista, força a exploração)
+            auto predicted = [&](int i) {
+                int t = std::min(run.par_levels[i], num_conflicting);
+                double unit = run.par_unit[i] >= 0
+                    ? run.par_unit[i]
+                    : run.par_unit[cur] * std::min(run.par_levels[cur], num_conflicting) / t;
+                return run.par_overhead[i] + num_conflicting * unit;
+            };
+            int best = cur;
+            for (int i = 0; i < L; ++i) if (predicted(i) < predicted(best)) best = i;
+            if (best != cur && run.par_hold >= SCAN_HOLD && predicted(best) < (1.0 - SCAN_HYSTERESIS) * predicted(cur)) {
+                run.par_level = best;
+                run.par_hold = 0;
+            }
+        }
+        run.par_hold++;
+        return std::min(run.par_levels[run.par_level], num_conflicting);
+    }
+
+    static void record_scan_time(TabuRun& run, int num_conflicting, double seconds) {
+        const int i = run.par_level;
+        double unit = std::max(0.0, seconds - run.par_overhead[i]) / std::max(1, num_conflicting);
+        run.par_unit[i] = run.par_unit[i] < 0 ? unit : 0.9 * run.par_unit[i] + 0.1 * unit;
+    }
+
+    // Publica o estado atual (stores relaxados; chamado fora do caminho de cada iteração)
+    void publish_metrics(TabuRun& run, SolverMetrics& M) const {
+        M.k.store(k, std::memory_order_relaxed);
+        M.obj.store(obj, std::memory_order_relaxed);
+        M.best_obj.store(run.best_obj_found, std::memory_order_relaxed);
+        M.conflicting.store((long long)conflictingVertices.size(), std::memory_order_relaxed);
+        M.iterations.fetch_add(run.iter - run.metrics_iter, std::memory_order_relaxed);
+        run.metrics_iter = run.iter;
+    }
+
+    // Deposita as classes sem conflito da solução atual no pool. O(n)
+    void harvest_classes(ClassPool& P) const {
+        std::vector<char> free_class(k, 1);
+        for (int v : conflictingVertices) free_class[color[v]] = 0;
+        P.add_coloring(color, k, free_class);
+    }
+
+    // Fecha a busca: preenche run.result e libera as estruturas auxiliares
+    void finish_search(TabuRun& run, const TabuConfig& config) {
+        if (config.metrics) publish_metrics(run, *config.metrics);
+        if (config.class_pool) harvest_classes(*config.class_pool);
+        if (config.memory_peak) {
+            MemoryReport R;
+            memory_report(R, "busca.");
+            config.memory_peak->offer(std::move(R));
+        }
+        run.result.iterations = run.iter;
+        run.result.final_obj = run.best_obj_found;
+        run.result.solved = (run.best_obj_found == 0);
+        run.result.search_seconds = run.elapsed();
+        run.finished = true;
+        if (run.persistent) return;
+        run.pool.reset();
+        release_color_counters();
+        release_class_members();
+        // A matriz tabu é recriada a cada busca: liberá-la evita que as cópias da
+        // solução (melhor, próxima) carreguem n x k inteiros à toa
+        std::vector<std::vector<int>>().swap(tabu_matrix);
+    }
+
+    // Reabre uma busca persistente a partir da solução atual (que pode ter ganho vértices,
+    // cores ou conflitos desde a pausa): a matriz tabu e as estruturas auxiliares continuam
+    // valendo, só a referência de melhora recomeça. O contador de iterações segue, para que
+    // as proibições antigas continuem coerentes; perto do limite do int, a matriz é zerada.
+    void resume_search(TabuRun& run) {
+        run.finished = false;
+        run.best_obj_found = obj;
+        run.window_best = run.best_obj_found;
+        run.no_improve_iter = 0;
+        if (run.iter > (1 << 30)) {
+            init_tabu();
+            run.iter = 0;
+            run.metrics_iter = 0;
+        }
+    }
+
+    // Executa até 'max_steps' iterações da busca iniciada por begin_search.
+    // Devolve true quando ela terminou (resultado em run.result) e false quando só pausou.
+    bool step_search(TabuRun& run, const TabuConfig& config, const StopCriterion& stop,
+                     long long max_steps = std::numeric_limits<long long>::max()) {
+        if (run.finished) return true;
+        run.slice_start = std::chrono::high_resolution_clock::now();
+
+        auto search_elapsed = [&]() { return run.elapsed(); };
+        auto charge_work = [&]() {
+            stop.add_work(work - run.work_charged);
+            run.work_charged = work;
+        };
+
+        // Apelidos para o estado persistente (o corpo do laço é o mesmo da versão contínua)
+        std::mt19937& rng = run.rng;
+        int& best_obj_found = run.best_obj_found;
+        int& iter = run.iter;
+        int& no_improve_iter = run.no_improve_iter;
+        double& sample_scale = run.sample_scale;
+        int& sample_nv = run.sample_nv;
+        int& sample_nc = run.sample_nc;
+        int& sample_np = run.sample_np;
+        int& window_best = run.window_best;
+        double& window_t0 = run.window_t0;
+        std::vector<int>& first_order = run.first_order;
+        WorkerPool* pool = run.pool.get();
+        std::vector<int>& local_best = run.local_best;
+        std::vector<std::vector<CandidateMove>>& local_cands = run.local_cands;
+        const int ADAPT_WINDOW = 64;
+
+        long long steps = 0;
 
         // Para identificar W+ e W-
         // W+ são classes com tamanho >= floor_size + 1 (na prática, igual a big_size)
         // W- são classes com tamanho <= floor_size
 
         while (iter < config.max_iter && obj > 0) {
-            if(iter % 128 == 0 && stop.is_time_up())
-                return result;
+            if (steps == max_steps) {
+                // Fatia esgotada: pausa (o estado fica em 'run')
+                run.active_seconds = run.elapsed();
+                charge_work();
+                return false;
+            }
+            steps++;
+
+            if (iter % config.time_check_every == 0) {
+                if (config.metrics) publish_metrics(run, *config.metrics);
+                // Orçamento esgotado: reporta o que foi feito até aqui
+                charge_work();
+                if (stop.is_time_up()) break;
+            }
             
             int best_delta = 99999999;
             int move_type = -1; // 0: Move, 1: Swap
@@ -677,20 +1879,32 @@ struct SolutionManager {
             // Movemos v de W+ para W-
 
             // Critério de perturbação simples: se nenhuma melhoria em X iterações, executa 
-            if (no_improve_iter >= config.perturbation_limit && config.perturbation_strength > 0) {
+            if (no_improve_iter >= config.perturbation_limit && (config.perturbation_strength > 0 || config.chain_moves > 0)) {
                 //printf("Perturbing solution at iter %d (stuck for %d iter)...\n", iter, no_improve_iter);
+                if (config.class_pool) harvest_classes(*config.class_pool); // ótimo local: colhe antes de estragar
                 
-                // Executa, por exemplo, n/2 swaps totalmente aleatórios
-                // Isso vai estragar o obj momentaneamente, mas tira do buraco
-                for (int p = 0; p < n * config.perturbation_strength; ++p) {
-                    std::uniform_int_distribution<int> d_n(0, n-1);
-                    int v1 = d_n(rng);
-                    int v2 = d_n(rng);
-                    if (v1 != v2 && color[v1] != color[v2]) {
-                        apply_swap_safe(v1, v2);
+                if (config.chain_moves > 0) {
+                    // Movimento grande: vértices de C(s) vão para a classe com menos vizinhos e a
+                    // equidade volta por caminhos de aumento de menor custo
+                    for (int p = 0; p < config.chain_moves && !conflictingVertices.empty(); ++p) {
+                        std::uniform_int_distribution<int> d_c(0, (int)conflictingVertices.size() - 1);
+                        ejection_chain(conflictingVertices[d_c(rng)]);
+                    }
+                } else {
+                    // Executa, por exemplo, n/2 swaps totalmente aleatórios
+                    // Isso vai estragar o obj momentaneamente, mas tira do buraco
+                    for (int p = 0; p < n * config.perturbation_strength; ++p) {
+                        std::uniform_int_distribution<int> d_n(0, n-1);
+                        int v1 = d_n(rng);
+                        int v2 = d_n(rng);
+                        if (v1 != v2 && color[v1] != color[v2]) {
+                            apply_swap_safe(v1, v2);
+                        }
                     }
                 }
                 
+                if (config.metrics) config.metrics->perturbations.fetch_add(1, std::memory_order_relaxed);
+
                 // Reseta o contador
                 no_improve_iter = 0;
                 iter++;
@@ -701,103 +1915,58 @@ struct SolutionManager {
                 continue;
             }
             
-            bool can_do_transfer = (n % k != 0); 
-            
-            if (can_do_transfer) {
-                // Candidatos: v pertencente a C(s) AND v está numa classe W+
-                // Iterar sobre conflictingVertices
-                for (int v : conflictingVertices) {
-                    int c_v = color[v];
-                    if (classSize[c_v] == big_size) { // v está em W+
-                        // Tentar mover para qualquer j em W-
-                        for (int j = 0; j < k; ++j) {
-                            if (classSize[j] == floor_size) { // j está em W-
-                                int delta = get_move_delta(v, c_v, j);
-                                
-                                // Tabu Check
-                                bool is_tabu = (tabu_matrix[v][j] > iter);
-                                // Aspiration Check
-                                bool aspiration = (obj + delta < best_obj_found);
-                                
-                                if (!is_tabu || (aspiration && config.aspiration)) {
-
-
-                                    if (delta < best_delta) {
-                                        best_delta = delta;
-                                        move_type = 0;
-                                        best_v = v;
-                                        best_u_or_color = j;
-                                        candidates.clear(); // Limpa candidatos anteriores
-                                        candidates.push_back({move_type, v, j}); // Adiciona o novo
-                                    }
-                                    else if (delta == best_delta) {
-                                        best_delta = delta;
-                                        move_type = 0;
-                                        best_v = v;
-                                        best_u_or_color = j;
-                                        // Empate: adiciona como candidato
-                                        candidates.push_back({move_type, v, j});
-                                    }
-                                    // Melhoria de primeiro nível (First Improvement) pode ser mais rápida?
-                                    // Tabu geralmente usa Best Improvement na vizinhança.
-                                }
-                            }
-                        }
-                    }
-                }
-            }
+            const long long evaluated = (long long)conflictingVertices.size();
+            work += config.scan_mode == 1 ? std::min<long long>(sample_nv, evaluated) : evaluated;
+
+            if (config.scan_mode == 1) {
+                // --- Vizinhança amostrada (lista de candidatos) ---
+                sample_neighbourhood(iter, best_obj_found, best_delta, candidates, config,
+                                     sample_nv, sample_nc, sample_np, rng);
+            } else if (config.scan_mode == 2) {
+                // --- First improvement em ordem aleatória ---
+                scan_first_improvement(iter, best_obj_found, best_delta, candidates, config, first_order, rng);
+            } else {
+                scan_transfer(iter, best_obj_found, best_delta, candidates, config);
 
-            // --- 2. Avaliar SWAP (Exchange) ---
-            // "Escolher v em C(s). Escolher u qualquer tal que (u not em C(s) OU color[u] < color[v])"
-            // Essa restrição reduz pela metade a busca em pares conflitantes e evita simetria.
+                // --- 2. Avaliar SWAP (Exchange) ---
+                // "Escolher v em C(s). Escolher u qualquer tal que (u not em C(s) OU color[u] < color[v])"
+                // Essa restrição reduz pela metade a busca em pares conflitantes e evita simetria.
             
-            // Dica de performance: Swap é O(N * |C(s)|). Isso pode ser pesado.
-            // Se estiver lento, amostrar apenas uma parte dos vizinhos ou usar lista de candidatos.
+                // Dica de performance: Swap é O(N * |C(s)|). Isso pode ser pesado.
+                // Se estiver lento, amostrar apenas uma parte dos vizinhos ou usar lista de candidatos.
             
-            for (int v : conflictingVertices) {
-                int c_v = color[v];
-                
-                // Iterar todos os vértices u para tentar troca
-                // (Em implementações avançadas, iteraríamos apenas u que tem cores diferentes e adjacências relevantes)
-                for (int u = 0; u < n; ++u) {
-                    if (v == u) continue;
-                    int c_u = color[u];
-                    if (c_v == c_u) continue; // Mesma cor, inútil trocar
-
-                    // Regra do artigo para evitar simetria e redundância
-                    bool u_in_conflicts = (conflicts[u] > 0);
-                    
-                    // Se u também é conflitante, só checa se c_u < c_v para não testar o par (v,u) e depois (u,v)
-                    if (u_in_conflicts && c_u > c_v) continue; 
-                    
-                    int delta = get_swap_delta(v, u);
-
-                    // Tabu Check para Swap?
-                    // Geralmente considera-se tabu se mover v para c_u OU mover u para c_v é tabu.
-                    bool is_tabu = (tabu_matrix[v][c_u] > iter) || (tabu_matrix[u][c_v] > iter);
-                    bool aspiration = (obj + delta < best_obj_found);
-
-                    if (!is_tabu || aspiration) {
-                        if (delta < best_delta) {
-                            best_delta = delta;
-                            move_type = 1;
-                            best_v = v;
-                            best_u_or_color = u;
-                            candidates.clear();
-                            candidates.push_back({move_type, v, u});
-                        }
-                        else if (delta == best_delta) {
-                            best_delta = delta;
-                            move_type = 1;
-                            best_v = v;
-                            best_u_or_color = u;
-                            candidates.push_back({move_type, v, u});// Empate: adiciona como candidato
+                const int num_conflicting = (int)conflictingVertices.size();
+                if (!pool || num_conflicting < 2) {
+                    scan_exchange(0, num_conflicting, iter, best_obj_found, best_delta, candidates, config);
+                } else if (scan_threads(run, num_conflicting, iter) == 1) {
+                    // Poucos conflitos: a barreira do pool custaria mais que a varredura
+                    auto t0 = std::chrono::steady_clock::now();
+                    scan_exchange(0, num_conflicting, iter, best_obj_found, best_delta, candidates, config);
+                    record_scan_time(run, num_conflicting, std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count());
+                } else {
+                    // Cada thread varre um bloco contíguo de C(s); a junção em ordem de bloco
+                    // reproduz exatamente a lista de empatados da varredura serial
+                    int T = std::min(run.par_levels[run.par_level], num_conflicting);
+                    auto t0 = std::chrono::steady_clock::now();
+                    pool->run(T, [&](int tid) {
+                        int lo = (int)((long long)num_conflicting * tid / T);
+                        int hi = (int)((long long)num_conflicting * (tid + 1) / T);
+                        local_best[tid] = 99999999;
+                        local_cands[tid].clear();
+                        scan_exchange(lo, hi, iter, best_obj_found, local_best[tid], local_cands[tid], config);
+                    });
+                    record_scan_time(run, num_conflicting, std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count());
+                    for (int t = 0; t < T; ++t) {
+                        if (local_best[t] < best_delta) {
+                            best_delta = local_best[t];
+                            candidates = local_cands[t];
+                        } else if (local_best[t] == best_delta) {
+                            candidates.insert(candidates.end(), local_cands[t].begin(), local_cands[t].end());
                         }
                     }
                 }
             }
 
-        
 
             // --- Escolher aleatoriamente entre os melhores candidatos ---
             if (!candidates.empty()) {
@@ -861,24 +2030,45 @@ struct SolutionManager {
                 else {
                     no_improve_iter++;
                 }
+            } else if (config.scan_mode != 0) {
+                // Amostra sem movimento admissível: a próxima amostra é outra
+                no_improve_iter++;
             } else {
                 // Travou (nenhum movimento não-tabu possível e sem aspiração)
                 // Isso é raro com aspiração, mas pode acontecer se a vizinhança for vazia
                 break; 
             }
 
+            // Ajuste das amostras: melhorando -> amostras menores (iterações mais baratas);
+            // estagnado e dentro do custo alvo -> amostras maiores; acima do custo -> menores
+            if (config.scan_mode == 1 && config.sample_adapt && iter % ADAPT_WINDOW == ADAPT_WINDOW - 1) {
+                double now = search_elapsed();
+                double us_per_iter = (now - window_t0) * 1e6 / ADAPT_WINDOW;
+                if (best_obj_found < window_best) sample_scale *= 0.8;
+                else if (us_per_iter < config.sample_target_us) sample_scale *= 1.25;
+                if (us_per_iter > 2.0 * config.sample_target_us) sample_scale *= 0.8;
+                sample_scale = std::min(64.0, std::max(0.125, sample_scale));
+
+                double root = std::sqrt(sample_scale);
+                sample_nv = std::max(1, (int)std::lround(config.sample_vertices * sample_scale));
+                sample_nc = std::max(1, (int)std::lround(config.sample_classes * root));
+                sample_np = std::max(1, (int)std::lround(config.sample_partners * root));
+
+                window_t0 = now;
+                window_best = best_obj_found;
+            }
+
             iter++;
     }
         
-        result.iterations = iter;
-        result.final_obj = best_obj_found;
-        result.solved = (best_obj_found == 0);
-
-        return result;
-
+        charge_work();
+        finish_search(run, config);
+        return true;
     }
 
 }; // end SolutionManager
 
+using SolutionManager = BasicSolutionManager<Instance>;
+
 } 
 
@@ -0,0 +1,432 @@
+// tiny_batch.hpp
+// C++17 header-only: TabuEQCol em lote para grafos minúsculos (n <= 64), em lockstep
+//
+// Usage example (sketch):
+//   TinyBatch T(config, max_iter);                 // TINY_LANES instâncias por bloco
+//   int lane = T.free_lane();
+//   T.load(lane, g, seed, &stop);                  // g com n <= TINY_N (fits_tiny)
+//   while (T.running()) T.step(256);               // uma iteração de cada pista por passo
+//   if (T.finished(lane)) { T.lane_best_k(lane); T.lane_best_color(lane); T.release(lane); }
+//
+// Para grafos desse tamanho o custo fixo do motor geral (CSR, vetores de estado, matriz
+// tabu, uma descida por job) supera a busca. Aqui cada instância é uma pista de um bloco
+// em layout struct-of-arrays: adjacência como uma máscara de 64 bits por vértice e
+// color/gamma/tabu/tamanhos guardados como [vértice][cor][pista], e todas as pistas
+// avançam uma iteração por passo. Com gamma denso o delta de qualquer movimento sai em
+// O(1); a avaliação varre só os vértices em conflito de cada pista (máscara de bits). Um
+// laço com as pistas no nível mais interno exigiria a união dos conflitos de todas as
+// pistas e leituras indexadas pela cor de cada uma (gathers), e mediu mais lento que o
+// motor geral; as atualizações em bloco (own, contagens) seguem entre pistas. O sorteio
+// entre movimentos empatados vira um ruído de hash nos bits baixos da chave, e a escolha
+// é um mínimo por pista (sem gerador por candidato).
+//
+// Cada pista roda a descida em k completa (Delta + 1, k - 1 a partir da solução de k, ...)
+// com a vizinhança de TabuEQCol (transfer W+ -> W- e exchange), aspiração e perturbação.
+
+#pragma once
+#include <cstdint>
+#include <climits>
+#include <vector>
+#include <algorithm>
+#include "tabu_search.hpp"
+#include "stopCriterion.hpp"
+
+namespace tabueqcol {
+
+constexpr int TINY_N = 64;     // vértices por instância (uma palavra de adjacência)
+constexpr int TINY_LANES = 8;  // instâncias por bloco (8 x int32 = um registrador AVX2)
+
+template <class Graph>
+inline bool fits_tiny(const Graph& g) {
+    return g.n >= 1 && g.n <= TINY_N;
+}
+
+class TinyBatch {
+public:
+    TinyBatch(const TabuConfig& config, long long max_iter) : config(config), max_iter(max_iter) {
+        // Pistas livres também passam pelos laços mascarados: o estado precisa ser válido
+        std::fill(&col[0][0], &col[0][0] + TINY_N * TINY_LANES, 0);
+        std::fill(&gam[0][0][0], &gam[0][0][0] + TINY_N * TINY_N * TINY_LANES, 0);
+        std::fill(&csize[0][0], &csize[0][0] + TINY_N * TINY_LANES, 0);
+        std::fill(&tabu[0][0][0], &tabu[0][0][0] + TINY_N * TINY_N * TINY_LANES, 0);
+        std::fill(&adj[0][0], &adj[0][0] + TINY_N * TINY_LANES, 0);
+        std::fill(std::begin(state), std::end(state), FREE);
+        std::fill(std::begin(conf), std::end(conf), 0);
+    }
+
+    // Pista livre ou -1
+    int free_lane() const {
+        for (int l = 0; l < TINY_LANES; ++l) {
+            if (state[l] == FREE) return l;
+        }
+        return -1;
+    }
+
+    bool running() const {
+        for (int l = 0; l < TINY_LANES; ++l) {
+            if (state[l] == RUNNING) return true;
+        }
+        return false;
+    }
+
+    bool finished(int l) const { return state[l] == DONE; }
+    bool empty() const { return free_lanes() == TINY_LANES; }
+
+    int free_lanes() const {
+        int c = 0;
+        for (int l = 0; l < TINY_LANES; ++l) c += state[l] == FREE;
+        return c;
+    }
+
+    // Carrega g na pista l e faz a construção inicial com k = Delta + 1.
+    // 'stop' é o prazo da pista (consultado a cada passo); deve viver até release(l).
+    template <class Graph>
+    void load(int l, const Graph& g, int seed, const StopCriterion* stop) {
+        state[l] = RUNNING;
+        deadline[l] = stop;
+        n[l] = g.n;
+        rng[l] = (uint32_t)seed * 2654435761u + 0x9E3779B9u;
+        if (rng[l] == 0) rng[l] = 1;
+        for (int v = 0; v < TINY_N; ++v) adj[v][l] = 0;
+        int max_degree = 0;
+        for (int v = 0; v < g.n; ++v) {
+            uint64_t row = 0;
+            g.for_each_neighbour(v, [&](int u) { row |= 1ULL << u; });
+            adj[v][l] = row;
+            max_degree = std::max(max_degree, popcount64(row));
+        }
+        initial_k[l] = best_k[l] = max_degree + 1;
+        total_iter[l] = 0;
+        set_k(l, best_k[l]);
+        construct(l, false);
+        if (obj[l] == 0) on_solved(l);
+        else begin_k(l);
+    }
+
+    // Executa até 'slice' iterações em lockstep; pistas que terminam ficam em DONE
+    void step(long long slice) {
+        for (long long s = 0; s < slice && running(); ++s) {
+            for (int l = 0; l < TINY_LANES; ++l) {
+                if (state[l] == RUNNING && (iter[l] % config.time_check_every) == 0 &&
+                    deadline[l] && deadline[l]->is_time_up()) {
+                    state[l] = DONE;
+                }
+            }
+            iterate();
+        }
+    }
+
+    int lane_initial_k(int l) const { return initial_k[l]; }
+    int lane_best_k(int l) const { return best_k[l]; }
+    long long lane_iterations(int l) const { return total_iter[l]; }
+
+    // Melhor coloração própria e equitativa encontrada (cores em [0, best_k))
+    std::vector<int> lane_best_color(int l) const {
+        std::vector<int> c(n[l]);
+        for (int v = 0; v < n[l]; ++v) c[v] = best_col[v][l];
+        return c;
+    }
+
+    void release(int l) {
+        state[l] = FREE;
+        deadline[l] = nullptr;
+    }
+
+private:
+    enum : uint8_t { FREE = 0, RUNNING = 1, DONE = 2 };
+
+    // ---------- Estado por pista (SoA: pista no índice mais interno) ----------
+    uint64_t adj[TINY_N][TINY_LANES];
+    int8_t col[TINY_N][TINY_LANES];
+    int8_t best_col[TINY_N][TINY_LANES];
+    uint8_t gam[TINY_N][TINY_N][TINY_LANES];   // gam[v][c][l]: vizinhos de v com cor c
+    uint8_t csize[TINY_N][TINY_LANES];         // tamanho da classe c
+    int32_t tabu[TINY_N][TINY_N][TINY_LANES];  // iteração até a qual v não volta para c
+    int32_t own[TINY_N][TINY_LANES];           // gam[v][col[v]] (conflitos de v), por iteração
+
+    int n[TINY_LANES], k[TINY_LANES], floor_size[TINY_LANES];
+    int obj[TINY_LANES], best_obj[TINY_LANES];
+    int iter[TINY_LANES], no_improve[TINY_LANES];
+    long long total_iter[TINY_LANES];
+    int initial_k[TINY_LANES], best_k[TINY_LANES];
+    uint64_t conf[TINY_LANES];                 // máscara dos vértices em conflito
+    uint32_t rng[TINY_LANES];
+    uint8_t state[TINY_LANES];
+    const StopCriterion* deadline[TINY_LANES] = {};
+
+    TabuConfig config;
+    long long max_iter;
+
+    uint32_t next_random(int l) {
+        uint32_t x = rng[l];
+        x ^= x << 13;
+        x ^= x >> 17;
+        x ^= x << 5;
+        return rng[l] = x;
+    }
+
+    static uint32_t mix(uint32_t x) {
+        x *= 0x9E3779B1u;
+        x ^= x >> 15;
+        x *= 0x85EBCA77u;
+        x ^= x >> 13;
+        return x;
+    }
+
+    void set_k(int l, int K) {
+        k[l] = K;
+        floor_size[l] = n[l] / K;
+    }
+
+    // Construção equitativa com a regra do M de construct_greedy_initial. Com from_previous,
+    // as cores atuais (já remapeadas para [0, k)) são mantidas e só os órfãos (col = -1)
+    // são colocados, como em construct_greedy_from_previous.
+    void construct(int l, bool from_previous) {
+        const int N = n[l], K = k[l], q = floor_size[l], r = N - q * K;
+        int order[TINY_N];
+        int m = 0;
+        for (int c = 0; c < TINY_N; ++c) csize[c][l] = 0;
+        for (int v = 0; v < N; ++v) {
+            if (!from_previous) col[v][l] = -1;
+            if (col[v][l] >= 0) csize[col[v][l]][l]++;
+            else order[m++] = v;
+        }
+        int big = 0;
+        for (int c = 0; c < K; ++c) big += csize[c][l] == q + 1;
+        for (int i = m - 1; i > 0; --i) std::swap(order[i], order[next_random(l) % (i + 1)]);
+
+        for (int i = 0; i < m; ++i) {
+            int v = order[i];
+            int M = big < r ? q + 1 : q;
+            uint64_t used = 0; // cores dos vizinhos já coloridos
+            for (uint64_t b = adj[v][l]; b; b &= b - 1) {
+                int c = col[ctz64(b)][l];
+                if (c >= 0) used |= 1ULL << c;
+            }
+            int chosen = -1, open = 0;
+            for (int c = 0; c < K; ++c) {
+                if (csize[c][l] >= M) continue;
+                open++;
+                if (chosen == -1 && !((used >> c) & 1)) chosen = c;
+            }
+            if (chosen == -1) {
+                int pick = (int)(next_random(l) % (uint32_t)std::max(1, open));
+                for (int c = 0; c < K; ++c) {
+                    if (csize[c][l] >= M) continue;
+                    if (pick-- == 0) {
+                        chosen = c;
+                        break;
+                    }
+                }
+            }
+            col[v][l] = (int8_t)chosen;
+            if (++csize[chosen][l] == q + 1) big++;
+        }
+        rebuild_counts(l);
+    }
+
+    // gamma, conflitos e f(s) da pista do zero (O(n * grau), só nas construções)
+    void rebuild_counts(int l) {
+        const int N = n[l];
+        for (int v = 0; v < TINY_N; ++v) {
+            for (int c = 0; c < TINY_N; ++c) gam[v][c][l] = 0;
+        }
+        int f = 0;
+        uint64_t cm = 0;
+        for (int v = 0; v < N; ++v) {
+            for (uint64_t b = adj[v][l]; b; b &= b - 1) gam[v][col[ctz64(b)][l]][l]++;
+            int cv = gam[v][col[v][l]][l];
+            f += cv;
+            if (cv > 0) cm |= 1ULL << v;
+        }
+        obj[l] = f / 2;
+        conf[l] = cm;
+    }
+
+    // Nova busca tabu no k atual da pista
+    void begin_k(int l) {
+        // Só a parte n x k da pista é lida pelas varreduras
+        for (int v = 0; v < n[l]; ++v) {
+            for (int c = 0; c < k[l]; ++c) tabu[v][c][l] = 0;
+        }
+        iter[l] = 0;
+        no_improve[l] = 0;
+        best_obj[l] = obj[l];
+    }
+
+    // f(s) = 0: guarda a solução e parte para k - 1 (remove uma cor sorteada)
+    void on_solved(int l) {
+        best_k[l] = k[l];
+        for (int v = 0; v < n[l]; ++v) best_col[v][l] = col[v][l];
+        if (k[l] == 1 || total_iter[l] >= max_iter) {
+            state[l] = DONE;
+            return;
+        }
+        int removed = (int)(next_random(l) % (uint32_t)k[l]);
+        for (int v = 0; v < n[l]; ++v) {
+            int c = col[v][l];
+            col[v][l] = (int8_t)(c == removed ? -1 : c == k[l] - 1 ? removed : c);
+        }
+        set_k(l, k[l] - 1);
+        construct(l, true);
+        if (obj[l] == 0) on_solved(l);
+        else begin_k(l);
+    }
+
+    void apply_move(int l, int v, int c) {
+        int old = col[v][l];
+        col[v][l] = (int8_t)c;
+        csize[old][l]--;
+        csize[c][l]++;
+        obj[l] += gam[v][c][l] - gam[v][old][l];
+        uint64_t touched = 1ULL << v;
+        for (uint64_t b = adj[v][l]; b; b &= b - 1) {
+            int u = ctz64(b);
+            gam[u][old][l]--;
+            gam[u][c][l]++;
+            touched |= 1ULL << u;
+        }
+        for (uint64_t b = touched; b; b &= b - 1) {
+            int u = ctz64(b);
+            if (gam[u][col[u][l]][l] > 0) conf[l] |= 1ULL << u;
+            else conf[l] &= ~(1ULL << u);
+        }
+    }
+
+    void perturb(int l) {
+        int swaps = (int)(n[l] * config.perturbation_strength);
+        for (int p = 0; p < swaps; ++p) {
+            int a = (int)(next_random(l) % (uint32_t)n[l]);
+            int b = (int)(next_random(l) % (uint32_t)n[l]);
+            int ca = col[a][l], cb = col[b][l];
+            if (a != b && ca != cb) {
+                apply_move(l, a, cb);
+                apply_move(l, b, ca);
+            }
+        }
+        // Só a parte n x k da pista é lida pelas varreduras
+        for (int v = 0; v < n[l]; ++v) {
+            for (int c = 0; c < k[l]; ++c) tabu[v][c][l] = 0;
+        }
+        no_improve[l] = 0;
+    }
+
+    // Uma iteração de tabu em todas as pistas ativas
+    void iterate() {
+        int32_t run_mask[TINY_LANES], salt[TINY_LANES], it[TINY_LANES], o[TINY_LANES], bo[TINY_LANES];
+        int32_t kk[TINY_LANES], nn[TINY_LANES], fl[TINY_LANES], transfer_ok[TINY_LANES];
+        int32_t best_key[TINY_LANES], best_mv[TINY_LANES];
+        bool any_running = false;
+        int nmax = 0;
+
+        for (int l = 0; l < TINY_LANES; ++l) {
+            run_mask[l] = 0;
+            best_key[l] = INT_MAX;
+            best_mv[l] = -1;
+            if (state[l] != RUNNING) continue;
+            if (no_improve[l] >= config.perturbation_limit && config.perturbation_strength > 0) {
+                perturb(l);
+                iter[l]++;
+                total_iter[l]++;
+                // As trocas aleatórias podem cair numa coloração própria
+                if (obj[l] == 0) on_solved(l);
+                else if (total_iter[l] >= max_iter) state[l] = DONE;
+                continue;
+            }
+            run_mask[l] = -1;
+            salt[l] = (int32_t)next_random(l);
+            it[l] = iter[l];
+            o[l] = obj[l];
+            bo[l] = best_obj[l];
+            kk[l] = k[l];
+            nn[l] = n[l];
+            fl[l] = floor_size[l];
+            transfer_ok[l] = (n[l] % k[l]) != 0 ? -1 : 0;
+            any_running = true;
+            nmax = std::max(nmax, n[l]);
+        }
+        if (!any_running) return;
+
+        for (int v = 0; v < nmax; ++v) {
+            for (int l = 0; l < TINY_LANES; ++l) own[v][l] = gam[v][col[v][l]][l];
+        }
+
+        const int asp = config.aspiration;
+        for (int l = 0; l < TINY_LANES; ++l) {
+            if (!run_mask[l]) continue;
+            for (uint64_t vb = conf[l]; vb; vb &= vb - 1) {
+                const int v = ctz64(vb);
+                const int cv = col[v][l];
+                const int ov = own[v][l];
+                if (transfer_ok[l] && csize[cv][l] == fl[l] + 1) {
+                    for (int c = 0; c < kk[l]; ++c) {
+                        if (csize[c][l] != fl[l]) continue;
+                        int32_t d = (int32_t)gam[v][c][l] - ov;
+                        bool admissible = tabu[v][c][l] <= it[l] || (asp && o[l] + d < bo[l]);
+                        int32_t key = ((d + 256) << 20) | (int32_t)(mix((uint32_t)salt[l] ^ (uint32_t)(v << 6 | c)) & 0xFFFFF);
+                        if (admissible && key < best_key[l]) {
+                            best_key[l] = key;
+                            best_mv[l] = v << 6 | c;
+                        }
+                    }
+                }
+                for (int u = 0; u < nn[l]; ++u) {
+                    int cu = col[u][l];
+                    if (cu == cv || (((conf[l] >> u) & 1) && cu > cv)) continue;
+                    int32_t e = (int32_t)((adj[v][l] >> u) & 1);
+                    int32_t d = (int32_t)gam[v][cu][l] - ov + (int32_t)gam[u][cv][l] - own[u][l] - 2 * e;
+                    int32_t key = ((d + 256) << 20) | (int32_t)(mix((uint32_t)salt[l] ^ (uint32_t)(4096 | v << 6 | u)) & 0xFFFFF);
+                    if (key >= best_key[l]) continue;
+                    bool admissible = (tabu[v][cu][l] <= it[l] && tabu[u][cv][l] <= it[l]) || o[l] + d < bo[l];
+                    if (admissible) {
+                        best_key[l] = key;
+                        best_mv[l] = 4096 | v << 6 | u;
+                    }
+                }
+            }
+        }
+
+        // Aplica o movimento escolhido em cada pista (escalar: O(grau))
+        for (int l = 0; l < TINY_LANES; ++l) {
+            if (!run_mask[l]) continue;
+            if (best_mv[l] < 0) {
+                // Nenhum movimento admissível: a busca neste k falha (como no motor geral)
+                state[l] = DONE;
+                continue;
+            }
+            int conflicting = popcount64(conf[l]);
+            int tenure = (int)(config.alpha * conflicting) + (int)(next_random(l) % (uint32_t)(config.beta + 1));
+            int v = (best_mv[l] >> 6) & 63;
+            if (best_mv[l] & 4096) {
+                int u = best_mv[l] & 63;
+                int cvo = col[v][l], cuo = col[u][l];
+                apply_move(l, v, cuo);
+                apply_move(l, u, cvo);
+                tabu[v][cvo][l] = iter[l] + tenure;
+                tabu[u][cuo][l] = iter[l] + tenure;
+            } else {
+                int c = best_mv[l] & 63;
+                int old = col[v][l];
+                apply_move(l, v, c);
+                tabu[v][old][l] = iter[l] + tenure;
+            }
+
+            if (obj[l] < best_obj[l]) {
+                best_obj[l] = obj[l];
+                no_improve[l] = 0;
+            } else {
+                no_improve[l]++;
+            }
+            iter[l]++;
+            total_iter[l]++;
+
+            if (obj[l] == 0) {
+                on_solved(l);
+            } else if (total_iter[l] >= max_iter) {
+                state[l] = DONE;
+            }
+        }
+    }
+};
+
+} // namespace tabueqcol
@@ -0,0 +1,139 @@
+// verify.hpp
+// C++17 header-only: verificação independente de uma coloração equitativa
+//
+// Checa, com varreduras paralelas da adjacência:
+//   - propriedade: nenhuma aresta com as duas pontas na mesma cor
+//   - equidade:    tamanhos das classes diferem em no máximo 1
+//   - k:           todas as cores em [0, k) e k classes usadas (quando k <= n)
+//
+// Usage example (sketch):
+//   auto rep = tabueqcol::verify_coloring(inst, S.color, S.k);
+//   if (!rep.ok()) { ... rep.violations ... }
+//
+
+#pragma once
+#include <vector>
+#include <string>
+#include <algorithm>
+#include "tabu_search.hpp"
+#include "parallel.hpp"
+
+namespace tabueqcol {
+
+struct Violation {
+    enum Kind { BAD_COLOR, CONFLICT_EDGE, CLASS_SIZE, SIZE_MISMATCH, BAD_K } kind;
+    int a; // vértice (BAD_COLOR, CONFLICT_EDGE), cor (CLASS_SIZE), cores lidas (SIZE_MISMATCH) ou k (BAD_K)
+    int b; // vizinho (CONFLICT_EDGE), tamanho da classe (CLASS_SIZE) ou n (SIZE_MISMATCH)
+
+    std::string describe() const {
+        switch (kind) {
+            case BAD_COLOR:     return "vertex " + std::to_string(a + 1) + " has color outside [1,k]";
+            case CONFLICT_EDGE: return "edge (" + std::to_string(a + 1) + "," + std::to_string(b + 1) + ") is monochromatic";
+            case CLASS_SIZE:    return "class " + std::to_string(a + 1) + " has size " + std::to_string(b);
+            case SIZE_MISMATCH: return "coloring has " + std::to_string(a) + " entries but the graph has " + std::to_string(b) + " vertices";
+            default:            return "k = " + std::to_string(a) + " is not positive";
+        }
+    }
+};
+
+struct VerifyReport {
+    bool proper = false;      // nenhuma aresta conflitante
+    bool equitable = false;   // max |Vi| - min |Vi| <= 1
+    bool k_ok = false;        // cores no intervalo e k classes usadas
+    long long conflicting_edges = 0;
+    int colors_used = 0;
+    int min_class = 0;
+    int max_class = 0;
+    std::vector<Violation> violations; // primeiras violações (ordenadas por vértice/cor)
+
+    bool ok() const { return proper && equitable && k_ok; }
+};
+
+// max_violations limita quantas violações são guardadas (a contagem total é sempre exata)
+// Genérico sobre o conceito de grafo (Instance ou grafo implícito)
+template <class Graph>
+inline VerifyReport verify_coloring(const Graph& inst, const std::vector<int>& color, int k,
+                                    int threads = 0, int max_violations = 10) {
+    VerifyReport rep;
+    const int n = inst.n;
+    if (threads <= 0) threads = default_thread_count();
+
+    if ((int)color.size() != n) {
+        rep.violations.push_back({Violation::SIZE_MISMATCH, (int)color.size(), n});
+        return rep;
+    }
+    if (k <= 0) {
+        rep.violations.push_back({Violation::BAD_K, k, 0});
+        return rep;
+    }
+
+    // Estado por thread: contagem de classes, conflitos e primeiras violações
+    struct Local {
+        std::vector<int> class_size;
+        long long conflicts = 0;
+        long long bad_colors = 0;
+        std::vector<Violation> found;
+    };
+    std::vector<Local> local(threads);
+    for (auto &L : local) L.class_size.assign(k, 0);
+
+    parallel_for(0, n, [&](long long lo, long long hi, int tid) {
+        Local &L = local[tid];
+        for (long long vv = lo; vv < hi; ++vv) {
+            int v = (int)vv;
+            int c = color[v];
+            if (c < 0 || c >= k) {
+                L.bad_colors++;
+                if ((int)L.found.size() < max_violations) L.found.push_back({Violation::BAD_COLOR, v, 0});
+                continue;
+            }
+            L.class_size[c]++;
+            // Cada aresta é conferida uma única vez (pela ponta de menor índice)
+            inst.for_each_neighbour(v, [&](int u) {
+                if (u > v && color[u] == c) {
+                    L.conflicts++;
+                    if ((int)L.found.size() < max_violations) L.found.push_back({Violation::CONFLICT_EDGE, v, u});
+                }
+            });
+        }
+    }, threads, 1 << 12);
+
+    // Redução
+    std::vector<int> class_size(k, 0);
+    long long bad_colors = 0;
+    for (auto &L : local) {
+        for (int c = 0; c < k; ++c) class_size[c] += L.class_size[c];
+        rep.conflicting_edges += L.conflicts;
+        bad_colors += L.bad_colors;
+        rep.violations.insert(rep.violations.end(), L.found.begin(), L.found.end());
+    }
+
+    // Os blocos são pegos em ordem arbitrária: ordena para que "primeiras" seja determinístico
+    std::sort(rep.violations.begin(), rep.violations.end(), [](const Violation& x, const Violation& y) {
+        if (x.a != y.a) return x.a < y.a;
+        return x.b < y.b;
+    });
+    if ((int)rep.violations.size() > max_violations) rep.violations.resize(max_violations);
+
+    rep.min_class = *std::min_element(class_size.begin(), class_size.end());
+    rep.max_class = *std::max_element(class_size.begin(), class_size.end());
+    for (int c = 0; c < k; ++c) if (class_size[c] > 0) rep.colors_used++;
+
+    rep.proper = (rep.conflicting_edges == 0);
+    rep.equitable = (bad_colors == 0) && (rep.max_class - rep.min_class <= 1);
+    rep.k_ok = (bad_colors == 0) && (rep.colors_used == std::min(k, n));
+
+    if (!rep.equitable && bad_colors == 0) {
+        // Reporta as classes fora de {floor(n/k), ceil(n/k)}
+        int lo = n / k, hi = (n + k - 1) / k;
+        for (int c = 0; c < k && (int)rep.violations.size() < max_violations; ++c) {
+            if (class_size[c] < lo || class_size[c] > hi) {
+                rep.violations.push_back({Violation::CLASS_SIZE, c, class_size[c]});
+            }
+        }
+    }
+
+    return rep;
+}
+
+} // namespace tabueqcol
@@ -0,0 +1,169 @@
+// sample.cpp - tabu_ecp_sample: gera instâncias proxy (menores) para calibrar TabuConfig
+// Uso: ./tabu_ecp_sample <instance_file> <out_prefix> [options]
+//   --n N                  tamanho do proxy (padrão: 10% de n, mínimo 50)
+//   --method ff|induced    forest fire (padrão) ou subgrafo induzido uniforme
+//   --pf P                 probabilidade de queima do forest fire (padrão 0.7)
+//   --count C              número de proxies (padrão 1)
+//   --seed S
+//   --no_density_fix       não corrige a densidade do proxy
+//   --probe_time T         roda a descida com algumas configurações (T segundos cada) no
+//                          grafo completo e nos proxies e reporta a correlação de Spearman
+//   --report file.csv      acrescenta o relatório em CSV
+//
+// Gera <out_prefix>_<i>.txt no formato de instância (1-based).
+
+#include "instance_io.hpp"
+#include "sampling.hpp"
+#include "descent.hpp"
+#include <iostream>
+#include <fstream>
+#include <cstring>
+#include <cstdio>
+
+// Configurações usadas na sonda de correlação (pontos típicos da calibração)
+static const TabuConfig PROBE_CONFIGS[] = {
+    {10000, 0.6, 10, 1000, 0.16, 1},
+    {10000, 0.3, 5,  500,  0.10, 1},
+    {10000, 0.9, 20, 2000, 0.25, 1},
+    {10000, 0.6, 10, 500,  0.05, 0},
+};
+static const int NUM_PROBES = sizeof(PROBE_CONFIGS) / sizeof(PROBE_CONFIGS[0]);
+
+// k relativo alcançado (best_k / initial_k): comparável entre grafos de tamanhos diferentes
+static double probe(const tabueqcol::Instance& I, const TabuConfig& cfg, double seconds, int seed) {
+    StopCriterion stop(seconds);
+    auto D = tabueqcol::run_descent(I, cfg, stop, seed, 1LL << 40);
+    return D.initial_k > 0 ? (double)D.best_k / D.initial_k : 1.0;
+}
+
+static std::vector<double> ranks(const std::vector<double>& x) {
+    std::vector<int> idx(x.size());
+    std::iota(idx.begin(), idx.end(), 0);
+    std::sort(idx.begin(), idx.end(), [&](int a, int b) { return x[a] < x[b]; });
+    std::vector<double> r(x.size());
+    for (size_t i = 0; i < idx.size();) {
+        size_t j = i;
+        while (j + 1 < idx.size() && x[idx[j + 1]] == x[idx[i]]) ++j;
+        for (size_t t = i; t <= j; ++t) r[idx[t]] = (i + j) / 2.0; // empates: posto médio
+        i = j + 1;
+    }
+    return r;
+}
+
+static double spearman(const std::vector<double>& a, const std::vector<double>& b) {
+    auto ra = ranks(a), rb = ranks(b);
+    double ma = std::accumulate(ra.begin(), ra.end(), 0.0) / ra.size();
+    double mb = std::accumulate(rb.begin(), rb.end(), 0.0) / rb.size();
+    double num = 0, da = 0, db = 0;
+    for (size_t i = 0; i < ra.size(); ++i) {
+        num += (ra[i] - ma) * (rb[i] - mb);
+        da += (ra[i] - ma) * (ra[i] - ma);
+        db += (rb[i] - mb) * (rb[i] - mb);
+    }
+    if (da == 0 || db == 0) return (da == db) ? 1.0 : 0.0;
+    return num / std::sqrt(da * db);
+}
+
+int main(int argc, char** argv) {
+    try {
+        if (argc < 3) {
+            std::cerr << "Usage: ./tabu_ecp_sample <instance_file> <out_prefix> [--n N] [--method ff|induced] [--pf P] "
+                         "[--count C] [--seed S] [--no_density_fix] [--probe_time T] [--report file.csv]\n";
+            return 2;
+        }
+
+        std::string instance_file = argv[1];
+        std::string out_prefix = argv[2];
+        int target_n = -1;
+        std::string method = "ff";
+        double pf = 0.7;
+        int count = 1;
+        int seed = 0;
+        bool density_fix = true;
+        double probe_time = 0.0;
+        std::string report_file;
+
+        for (int i = 3; i < argc; ++i) {
+            auto eq = [&](const char* s){ return strcmp(argv[i], s) == 0; };
+            if (eq("--no_density_fix")) { density_fix = false; continue; }
+            if (i + 1 >= argc) throw std::runtime_error(std::string("Missing value for argument: ") + argv[i]);
+
+            if (eq("--n")) target_n = std::stoi(argv[++i]);
+            else if (eq("--method")) method = argv[++i];
+            else if (eq("--pf")) pf = std::stod(argv[++i]);
+            else if (eq("--count")) count = std::stoi(argv[++i]);
+            else if (eq("--seed")) seed = std::stoi(argv[++i]);
+            else if (eq("--probe_time")) probe_time = std::stod(argv[++i]);
+            else if (eq("--report")) report_file = argv[++i];
+            else throw std::runtime_error(std::string("Unknown argument: ") + argv[i]);
+        }
+        if (method != "ff" && method != "induced") throw std::runtime_error("--method must be ff or induced");
+        if (!(pf > 0.0 && pf < 1.0)) throw std::runtime_error("--pf must be in (0, 1)");
+
+        const tabueqcol::Instance full = tabueqcol::read_instance(instance_file);
+        if (target_n <= 0) target_n = std::max(50, full.n / 10);
+        target_n = std::min(target_n, full.n);
+
+        // Estatísticas do grafo completo (agrupamento estimado por amostra em grafos grandes)
+        const int clustering_samples = full.n > 20000 ? 20000 : 0;
+        auto full_stats = tabueqcol::graph_stats(full, clustering_samples, seed);
+
+        printf("FULL   n=%d m=%lld dens=%.4f avgdeg=%.2f cv=%.3f clust=%.4f\n",
+               full_stats.n, full_stats.m, full_stats.density, full_stats.avg_degree,
+               full_stats.degree_cv, full_stats.clustering);
+
+        std::vector<double> full_probe;
+        if (probe_time > 0) {
+            for (int c = 0; c < NUM_PROBES; ++c) full_probe.push_back(probe(full, PROBE_CONFIGS[c], probe_time, seed));
+        }
+
+        std::ofstream report;
+        if (!report_file.empty()) {
+            report.open(report_file, std::ios::app);
+            report.seekp(0, std::ios::end);
+            if (report.tellp() == 0) {
+                report << "Instance;Proxy;Method;N;M;Density;DegCV;Clustering;"
+                       << "KS;DensityRatio;CVRatio;ClusteringRatio;Score;Spearman\n";
+            }
+        }
+
+        for (int i = 0; i < count; ++i) {
+            int s = seed + i;
+            tabueqcol::Instance P = (method == "ff")
+                ? tabueqcol::sample_forest_fire(full, target_n, pf, s)
+                : tabueqcol::sample_induced(full, target_n, s);
+            if (density_fix) tabueqcol::correct_density(P, full_stats.density, s);
+
+            auto st = tabueqcol::graph_stats(P, 0, s);
+            auto fid = tabueqcol::compare_stats(full_stats, st);
+
+            std::string out_file = out_prefix + "_" + std::to_string(i + 1) + ".txt";
+            tabueqcol::write_instance(out_file, P);
+
+            double rho = std::numeric_limits<double>::quiet_NaN();
+            if (probe_time > 0) {
+                std::vector<double> proxy_probe;
+                for (int c = 0; c < NUM_PROBES; ++c) proxy_probe.push_back(probe(P, PROBE_CONFIGS[c], probe_time, s));
+                rho = spearman(full_probe, proxy_probe);
+            }
+
+            printf("PROXY  %s n=%d m=%lld dens=%.4f cv=%.3f clust=%.4f | KS=%.3f dens=%.2f cv=%.2f clust=%.2f score=%.3f",
+                   out_file.c_str(), st.n, st.m, st.density, st.degree_cv, st.clustering,
+                   fid.ks_rel_degree, fid.density_ratio, fid.cv_ratio, fid.clustering_ratio, fid.score);
+            if (probe_time > 0) printf(" spearman=%.3f", rho);
+            printf("\n");
+
+            if (report.is_open()) {
+                report << instance_file << ";" << out_file << ";" << method << ";"
+                       << st.n << ";" << st.m << ";" << st.density << ";" << st.degree_cv << ";" << st.clustering << ";"
+                       << fid.ks_rel_degree << ";" << fid.density_ratio << ";" << fid.cv_ratio << ";"
+                       << fid.clustering_ratio << ";" << fid.score << ";" << rho << "\n";
+            }
+        }
+
+    } catch (const std::exception& e) {
+        std::cerr << "Exception: " << e.what() << "\n";
+        return 2;
+    }
+    return 0;
+}
@@ -0,0 +1,328 @@
+// scaling.cpp - tabu_ecp_scaling: escalabilidade dos modos paralelos por número de threads
+// Uso: ./tabu_ecp_scaling <instance_file> [options]      (instance_file é ignorado com --weak)
+//   --modes scan,portfolio,probe,build   modos medidos (padrão: todos)
+//                                        scan       varredura de exchange em paralelo (TabuConfig.threads)
+//                                        portfolio  motores do portfólio (portfolio.hpp)
+//                                        probe      sondagem abaixo da primeira falha (probing.hpp)
+//                                        build      construção paralela do CSR (Instance::build_adj)
+//   --threads 1,2,4                      contagens de threads (padrão: 1, 2, 4, ... e todos os núcleos)
+//   --seeds 1,2                          sementes (padrão: 1)
+//   --time T                             limite de cada execução em segundos (padrão 10)
+//   --target_k K                         alvo do tempo-até-k (padrão: melhor k da execução com 1 thread;
+//                                        só na escalabilidade forte)
+//   --weak N0                            escalabilidade fraca: em vez da instância, geométrico aleatório
+//                                        com N0 * t vértices para t threads (grau médio --weak_degree)
+//   --weak_degree D                      grau médio do geométrico (padrão 20)
+//   --idle_flag F                        marca contenção quando a fração ociosa passa de F (padrão 0.25)
+//   --report file.csv                    acrescenta uma linha por execução (CSV com ';')
+//
+// Por execução: trabalho (iterações do tabu; arestas no build), vazão, melhor k, tempo até o
+// alvo, speedup e eficiência em relação à execução com 1 thread do mesmo modo e semente
+// (forte: vazão_t / vazão_1 / t; fraca: vazão_t / (t * vazão_1), com trabalho por thread
+// constante) e a ociosidade por thread medida pelo perfil de parallel.hpp. Na escalabilidade
+// fraca cada contagem de threads resolve outra instância, então tempo até o alvo não se
+// compara: as colunas do alvo ficam vazias. A thread mais
+// ociosa aponta o gargalo: barreira do pool (scan), blocos desiguais (build) ou sondas que
+// terminam cedo (probe).
+
+#include "instance_io.hpp"
+#include "implicit_graphs.hpp"
+#include "descent.hpp"
+#include "portfolio.hpp"
+#include "probing.hpp"
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <cstring>
+#include <cstdio>
+#include <cmath>
+#include <thread>
+
+namespace {
+
+struct RunResult {
+    double seconds = 0.0;
+    long long work = 0;           // iterações do tabu (arestas no build)
+    int best_k = 0;
+    std::vector<std::pair<int,double>> trace; // (k resolvido, segundos) a cada melhora
+    double time_to_target = -1.0; // -1 = não atingiu (preenchido por quem conhece o alvo)
+    double idle_fraction = 0.0;   // soma do ocioso / soma dos spans das threads usadas
+    int idle_max_thread = 0;
+    double idle_max_seconds = 0.0;
+};
+
+std::vector<int> parse_list(const std::string& s) {
+    std::vector<int> out;
+    std::stringstream in(s);
+    for (std::string tok; std::getline(in, tok, ',');) {
+        if (!tok.empty()) out.push_back(std::stoi(tok));
+    }
+    return out;
+}
+
+std::vector<std::string> parse_names(const std::string& s) {
+    std::vector<std::string> out;
+    std::stringstream in(s);
+    for (std::string tok; std::getline(in, tok, ',');) {
+        if (!tok.empty()) out.push_back(tok);
+    }
+    return out;
+}
+
+tabueqcol::Instance materialize(const tabueqcol::GeometricGraph& g) {
+    tabueqcol::Instance I;
+    I.n = g.n;
+    for (int v = 0; v < g.n; ++v) {
+        g.for_each_neighbour(v, [&](int u) { if (u > v) I.edges.emplace_back(v, u); });
+    }
+    I.build_adj();
+    return I;
+}
+
+// Instância da escalabilidade fraca para t threads: N0 * t vértices, mesmo grau médio
+tabueqcol::Instance weak_instance(int n0, int threads, double degree, int seed) {
+    int n = n0 * threads;
+    const double pi = std::acos(-1.0);
+    double r = std::sqrt(degree / (pi * n));
+    return materialize(tabueqcol::GeometricGraph(n, r, seed));
+}
+
+TabuConfig base_config(const tabueqcol::Instance& I) {
+    TabuConfig cfg;
+    cfg.max_iter = 100000;
+    // Contadores densos quando cabem: é a combinação em que a varredura paralela compensa
+    if ((size_t)I.n * (I.max_degree + 1) * sizeof(int) <= (size_t)1 << 30) {
+        cfg.dense_counters = 1;
+        cfg.block_scan = 1;
+    }
+    return cfg;
+}
+
+RunResult run_mode(const tabueqcol::Instance& I, const std::string& mode, int threads, int seed,
+                   double time_limit) {
+    RunResult R;
+    tabueqcol::ThreadProfile P;
+    tabueqcol::set_thread_profile(&P);
+    auto t0 = std::chrono::steady_clock::now();
+    auto elapsed = [&]() { return std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count(); };
+
+    if (mode == "build") {
+        // Lista de arestas refeita a partir do CSR; a construção repete até gastar o limite
+        std::vector<std::pair<int,int>> E;
+        E.reserve(I.m);
+        for (int v = 0; v < I.n; ++v) {
+            for (int u : I.adj[v]) if (u > v) E.emplace_back(v, u);
+        }
+        P.reset();
+        t0 = std::chrono::steady_clock::now();
+        do {
+            tabueqcol::Instance J;
+            J.n = I.n;
+            J.edges = E;
+            J.build_adj(threads);
+            R.work += (long long)E.size();
+        } while (elapsed() < std::min(time_limit, 2.0));
+        R.best_k = 0;
+    } else {
+        tabueqcol::SolverMetrics M;
+        TabuConfig cfg = base_config(I);
+        cfg.metrics = &M;
+
+        // Observador do tempo até cada k (amostra best_k a cada milissegundo)
+        std::atomic<bool> done{false};
+        auto sample = [&]() {
+            int k = (int)M.best_k.load(std::memory_order_relaxed);
+            if (k > 0 && (R.trace.empty() || k < R.trace.back().first)) R.trace.push_back({k, elapsed()});
+        };
+        std::thread watcher([&]() {
+            while (!done.load()) {
+                sample();
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+        });
+
+        StopCriterion stop(time_limit);
+        const long long max_iter = 1LL << 40;
+        if (mode == "scan") {
+            cfg.threads = threads;
+            auto D = tabueqcol::run_descent(I, cfg, stop, seed, max_iter);
+            R.work = D.total_iterations;
+            R.best_k = D.best_k;
+        } else if (mode == "portfolio") {
+            auto Pf = tabueqcol::run_portfolio(I, cfg, stop, seed, cfg.max_iter, threads);
+            R.work = Pf.descent.total_iterations;
+            R.best_k = Pf.descent.best_k;
+        } else if (mode == "probe") {
+            // Mesma profundidade para todas as contagens: o trabalho total não muda com t
+            int depth = std::max(4, (int)std::thread::hardware_concurrency());
+            auto D = tabueqcol::run_probing_descent(I, cfg, stop, seed, cfg.max_iter, depth, threads);
+            R.work = D.total_iterations;
+            R.best_k = D.best_k;
+        } else {
+            done.store(true);
+            watcher.join();
+            tabueqcol::set_thread_profile(nullptr);
+            throw std::runtime_error("Unknown mode: " + mode);
+        }
+        done.store(true);
+        watcher.join();
+        sample();
+    }
+    R.seconds = elapsed();
+    tabueqcol::set_thread_profile(nullptr);
+
+    double idle = 0.0, span = 0.0;
+    for (int t = 0; t < threads && t < tabueqcol::ThreadProfile::MAX_THREADS; ++t) {
+        idle += P.idle_seconds(t);
+        span += P.span_seconds(t);
+        if (P.idle_seconds(t) > R.idle_max_seconds) {
+            R.idle_max_seconds = P.idle_seconds(t);
+            R.idle_max_thread = t;
+        }
+    }
+    R.idle_fraction = span > 0 ? idle / span : 0.0;
+    return R;
+}
+
+// Primeiro instante em que o k resolvido chegou a 'target' (-1 = não chegou)
+double time_to(const RunResult& R, int target) {
+    if (target <= 0) return -1.0;
+    for (const auto& [k, t] : R.trace) {
+        if (k <= target) return t;
+    }
+    return -1.0;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    try {
+        if (argc < 2) {
+            std::cerr << "Usage: ./tabu_ecp_scaling <instance_file> [--modes scan,portfolio,probe,build] "
+                         "[--threads 1,2,4] [--seeds 1,2] [--time T] [--target_k K] [--weak N0] "
+                         "[--weak_degree D] [--idle_flag F] [--report file.csv]\n";
+            return 2;
+        }
+
+        std::string instance_file = argv[1];
+        std::vector<std::string> modes = {"scan", "portfolio", "probe", "build"};
+        std::vector<int> thread_counts;
+        std::vector<int> seeds = {1};
+        double time_limit = 10.0;
+        int target_k = 0;
+        int weak_n0 = 0;
+        double weak_degree = 20.0;
+        double idle_flag = 0.25;
+        std::string report_file;
+
+        for (int i = 2; i < argc; ++i) {
+            auto eq = [&](const char* s){ return strcmp(argv[i], s) == 0; };
+            if (i + 1 >= argc) throw std::runtime_error(std::string("Missing value for argument: ") + argv[i]);
+
+            if (eq("--modes")) modes = parse_names(argv[++i]);
+            else if (eq("--threads")) thread_counts = parse_list(argv[++i]);
+            else if (eq("--seeds")) seeds = parse_list(argv[++i]);
+            else if (eq("--time")) time_limit = std::stod(argv[++i]);
+            else if (eq("--target_k")) target_k = std::stoi(argv[++i]);
+            else if (eq("--weak")) weak_n0 = std::stoi(argv[++i]);
+            else if (eq("--weak_degree")) weak_degree = std::stod(argv[++i]);
+            else if (eq("--idle_flag")) idle_flag = std::stod(argv[++i]);
+            else if (eq("--report")) report_file = argv[++i];
+            else throw std::runtime_error(std::string("Unknown argument: ") + argv[i]);
+        }
+        for (const auto& m : modes) {
+            if (m != "scan" && m != "portfolio" && m != "probe" && m != "build") {
+                throw std::runtime_error("--modes accepts scan, portfolio, probe and build");
+            }
+        }
+
+        const int cores = tabueqcol::default_thread_count();
+        if (thread_counts.empty()) {
+            for (int t = 1; t < cores; t *= 2) thread_counts.push_back(t);
+            thread_counts.push_back(cores);
+        }
+        std::sort(thread_counts.begin(), thread_counts.end());
+        thread_counts.erase(std::unique(thread_counts.begin(), thread_counts.end()), thread_counts.end());
+        if (thread_counts.front() < 1) throw std::runtime_error("--threads must be >= 1");
+        // A base (speedup e alvo) é a execução com 1 thread
+        if (thread_counts.front() != 1) thread_counts.insert(thread_counts.begin(), 1);
+
+        const bool weak = weak_n0 > 0;
+        if (weak && target_k > 0) throw std::runtime_error("--target_k does not apply to --weak (one instance per thread count)");
+        const char* scaling = weak ? "weak" : "strong";
+        tabueqcol::Instance strong_inst;
+        if (!weak) strong_inst = tabueqcol::read_instance(instance_file);
+
+        std::ofstream report;
+        if (!report_file.empty()) {
+            report.open(report_file, std::ios::app);
+            report.seekp(0, std::ios::end);
+            if (report.tellp() == 0) {
+                report << "Scaling;Mode;Instance;N;M;Seed;Threads;Time(s);Work;Rate;BestK;TargetK;TimeToTarget(s);"
+                       << "Speedup;Efficiency;TargetSpeedup;IdleFrac;IdleMaxThread;IdleMax(s)\n";
+            }
+        }
+
+        printf("%-6s %-9s %7s %4s %3s %9s %12s %12s %5s %9s %7s %6s %6s\n", "escala", "modo", "n", "seed", "t",
+               "tempo(s)", "trabalho", "vazao", "k", "alvo(s)", "speedup", "efic", "ocioso");
+
+        for (const auto& mode : modes) {
+            for (int seed : seeds) {
+                RunResult base;
+                int target = target_k;
+                for (int t : thread_counts) {
+                    tabueqcol::Instance weak_inst;
+                    if (weak) weak_inst = weak_instance(weak_n0, t, weak_degree, seed);
+                    const tabueqcol::Instance& I = weak ? weak_inst : strong_inst;
+
+                    RunResult R = run_mode(I, mode, t, seed, time_limit);
+                    if (weak) {
+                        // Instância diferente por t: sem alvo comum
+                        R.time_to_target = -1.0;
+                        if (t == 1) base = R;
+                    } else if (t == 1) {
+                        // Sem alvo explícito: o k que a execução serial alcançou
+                        if (target <= 0 && R.best_k > 0) target = R.best_k;
+                        R.time_to_target = time_to(R, target);
+                        base = R;
+                    }
+                    if (!weak) R.time_to_target = time_to(R, target);
+
+                    double rate = R.seconds > 0 ? R.work / R.seconds : 0.0;
+                    double base_rate = base.seconds > 0 ? base.work / base.seconds : 0.0;
+                    double speedup = base_rate > 0 ? rate / base_rate : 0.0;
+                    double efficiency = speedup / t;
+                    double target_speedup = (R.time_to_target > 0 && base.time_to_target > 0)
+                                            ? base.time_to_target / R.time_to_target : 0.0;
+
+                    char target_col[32] = "-";
+                    if (!weak) snprintf(target_col, sizeof(target_col), "%.3f", R.time_to_target);
+                    printf("%-6s %-9s %7d %4d %3d %9.3f %12lld %12.0f %5d %9s %7.2f %6.2f %5.1f%%\n", scaling,
+                           mode.c_str(), I.n, seed, t, R.seconds, R.work, rate, R.best_k, target_col,
+                           speedup, efficiency, 100.0 * R.idle_fraction);
+                    if (t > 1 && R.idle_fraction > idle_flag) {
+                        printf("  [contencao] %s t=%d: %.1f%% do tempo das threads ocioso (mais ociosa: thread %d, %.3fs)\n",
+                               mode.c_str(), t, 100.0 * R.idle_fraction, R.idle_max_thread, R.idle_max_seconds);
+                    }
+
+                    if (report.is_open()) {
+                        report << scaling << ";" << mode << ";" << (weak ? "geometric" : instance_file) << ";"
+                               << I.n << ";" << I.m << ";" << seed << ";" << t << ";" << R.seconds << ";"
+                               << R.work << ";" << rate << ";" << R.best_k << ";";
+                        if (weak) report << ";;";
+                        else report << target << ";" << R.time_to_target << ";";
+                        report << speedup << ";" << efficiency << ";";
+                        if (!weak) report << target_speedup;
+                        report << ";"
+                               << R.idle_fraction << ";" << R.idle_max_thread << ";" << R.idle_max_seconds << "\n";
+                    }
+                }
+            }
+        }
+
+    } catch (const std::exception& e) {
+        std::cerr << "Exception: " << e.what() << "\n";
+        return 2;
+    }
+    return 0;
+}